@@ -0,0 +1,395 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of the Nedrysoft SettingsDialog. (https://github.com/nedrysoft/SettingsDialog)
+ *
+ * A cross-platform settings dialog
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ISettingsPage.h"
+#include "SettingsDialog.h"
+
+#include <QApplication>
+#include <QCheckBox>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFormLayout>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLabel>
+#include <QLineEdit>
+#include <QListView>
+#include <QPixmap>
+#include <QPushButton>
+#include <QSpinBox>
+#include <ThemeSupport>
+
+#include <cstdio>
+
+#if defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#endif
+
+constexpr auto DefaultPageCount = 60;
+constexpr auto DefaultSectionCount = 20;
+constexpr auto DefaultWidgetCount = 20;
+constexpr auto DefaultIterations = 5;
+constexpr auto HostWidth = 1600;
+constexpr auto HostHeight = 1200;
+constexpr auto IconSize = 32;
+constexpr auto NanosecondsPerMillisecond = 1000000.0;
+
+namespace Nedrysoft { namespace SettingsDialog { namespace Benchmark {
+    /**
+     * @brief       The SyntheticSettingsPage class is a generated settings page used to measure the dialog.
+     *
+     * @details     The widget created by the page contains a configurable number of rows, each row is a label
+     *              and an editor so that the cost of a page can be scaled to match real world pages.
+     */
+    class SyntheticSettingsPage :
+            public Nedrysoft::SettingsDialog::ISettingsPage {
+
+        public:
+            /**
+             * @brief       Constructs a new SyntheticSettingsPage.
+             *
+             * @param[in]   section the section the page appears in.
+             * @param[in]   category the category the page appears in.
+             * @param[in]   widgetCount the number of editor rows created by the page widget.
+             */
+            SyntheticSettingsPage(const QString &section, const QString &category, int widgetCount) :
+                    m_section(section),
+                    m_category(category),
+                    m_widgetCount(widgetCount),
+                    m_acceptedValue(0) {
+
+            }
+
+            auto section() -> QString override {
+                return m_section;
+            }
+
+            auto category() -> QString override {
+                return m_category;
+            }
+
+            auto description() -> QString override {
+                return QString("%1 settings for %2").arg(m_category).arg(m_section);
+            }
+
+            auto icon(bool isDarkMode) -> QIcon override {
+                QPixmap pixmap(IconSize, IconSize);
+
+                pixmap.fill(isDarkMode ? Qt::white : Qt::black);
+
+                return QIcon(pixmap);
+            }
+
+            auto createWidget() -> QWidget * override {
+                auto widget = new QWidget;
+                auto layout = new QFormLayout;
+
+                m_spinBoxes.clear();
+
+                for (auto row=0;row<m_widgetCount;row++) {
+                    auto label = QString("Setting %1").arg(row);
+
+                    switch(row%3) {
+                        case 0: {
+                            layout->addRow(label, new QLineEdit(label));
+                            break;
+                        }
+
+                        case 1: {
+                            layout->addRow(label, new QCheckBox);
+                            break;
+                        }
+
+                        default: {
+                            auto spinBox = new QSpinBox;
+
+                            spinBox->setValue(row);
+
+                            m_spinBoxes.append(spinBox);
+
+                            layout->addRow(label, spinBox);
+                            break;
+                        }
+                    }
+                }
+
+                widget->setLayout(layout);
+
+                return widget;
+            }
+
+            auto canAcceptSettings() -> bool override {
+                return true;
+            }
+
+            auto acceptSettings() -> void override {
+                m_acceptedValue = 0;
+
+                for (auto spinBox : m_spinBoxes) {
+                    m_acceptedValue += spinBox->value();
+                }
+            }
+
+            /**
+             * @brief       Simulates the user editing the page.
+             */
+            auto modify() -> void {
+                Q_EMIT settingsChanged();
+            }
+
+        private:
+            //! @cond
+
+            QString m_section;
+            QString m_category;
+            int m_widgetCount;
+            int m_acceptedValue;
+            QList<QSpinBox *> m_spinBoxes;
+
+            //! @endcond
+    };
+}}}
+
+/**
+ * @brief       Returns the elapsed time of a timer in milliseconds.
+ *
+ * @param[in]   timer the timer.
+ *
+ * @returns     the elapsed time in milliseconds.
+ */
+static auto elapsedMilliseconds(const QElapsedTimer &timer) -> double {
+    return static_cast<double>(timer.nsecsElapsed())/NanosecondsPerMillisecond;
+}
+
+/**
+ * @brief       Returns the peak resident set size of the process.
+ *
+ * @returns     the peak RSS in kilobytes; or -1 if not available on this platform.
+ */
+static auto peakResidentSetSize() -> qint64 {
+#if defined(Q_OS_UNIX)
+    struct rusage usage = {};
+
+    if (getrusage(RUSAGE_SELF, &usage)==0) {
+#if defined(Q_OS_MACOS)
+        return static_cast<qint64>(usage.ru_maxrss)/1024;
+#else
+        return static_cast<qint64>(usage.ru_maxrss);
+#endif
+    }
+#endif
+    return -1;
+}
+
+int main(int argc, char **argv) {
+    using Nedrysoft::SettingsDialog::Benchmark::SyntheticSettingsPage;
+
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication application(argc, argv);
+
+    QCommandLineParser parser;
+
+    parser.setApplicationDescription("Measures the cost of constructing and using the settings dialog.");
+    parser.addHelpOption();
+
+    QCommandLineOption pagesOption("pages", "Number of synthetic pages.", "count", QString::number(DefaultPageCount));
+    QCommandLineOption sectionsOption("sections", "Number of sections the pages are spread over.", "count", QString::number(DefaultSectionCount));
+    QCommandLineOption widgetsOption("widgets", "Number of editor rows in each page widget.", "count", QString::number(DefaultWidgetCount));
+    QCommandLineOption iterationsOption("iterations", "Number of times each measurement is repeated.", "count", QString::number(DefaultIterations));
+    QCommandLineOption lazyOption("lazy", "Construct the dialog with lazily created pages.");
+    QCommandLineOption traceOption("trace", "Write the dialog timings to a Chrome trace file.", "filename");
+
+    parser.addOptions({pagesOption, sectionsOption, widgetsOption, iterationsOption, lazyOption, traceOption});
+
+    parser.process(application);
+
+    auto pageCount = qMax(1, parser.value(pagesOption).toInt());
+    auto sectionCount = qBound(1, parser.value(sectionsOption).toInt(), pageCount);
+    auto widgetCount = qMax(0, parser.value(widgetsOption).toInt());
+    auto iterations = qMax(1, parser.value(iterationsOption).toInt());
+
+    auto options = Nedrysoft::SettingsDialog::SettingsDialog::Options(Nedrysoft::SettingsDialog::SettingsDialog::NoOptions);
+
+    if (parser.isSet(lazyOption)) {
+        options |= Nedrysoft::SettingsDialog::SettingsDialog::LazyPages;
+    }
+
+    if (parser.isSet(traceOption)) {
+        options |= Nedrysoft::SettingsDialog::SettingsDialog::Tracing;
+    }
+
+    QList<Nedrysoft::SettingsDialog::ISettingsPage *> pages;
+
+    for (auto pageIndex=0;pageIndex<pageCount;pageIndex++) {
+        pages.append(new SyntheticSettingsPage(
+                QString("Section %1").arg(pageIndex%sectionCount),
+                QString("Category %1").arg(pageIndex/sectionCount),
+                widgetCount));
+    }
+
+    // the dialog sizes itself from its parent, so a host window is required
+
+    QWidget host;
+
+    host.resize(HostWidth, HostHeight);
+
+    QElapsedTimer timer;
+
+    timer.start();
+
+    auto settingsDialog = new Nedrysoft::SettingsDialog::SettingsDialog(pages, options, &host);
+
+    auto constructorTime = elapsedMilliseconds(timer);
+
+    timer.restart();
+
+    settingsDialog->show();
+
+    QApplication::processEvents();
+
+    auto firstShowTime = elapsedMilliseconds(timer);
+
+    // page switching, every section is visited in turn
+
+    QJsonArray pageSwitchTimes;
+    auto pageSwitchTotal = 0.0;
+    auto pageSwitchMaximum = 0.0;
+    auto pageSwitchCount = 0;
+
+    auto navigationView = settingsDialog->findChild<QListView *>();
+
+    if (navigationView) {
+        auto sectionModel = navigationView->model();
+
+        for (auto iteration=0;iteration<iterations;iteration++) {
+            for (auto row=0;row<sectionModel->rowCount();row++) {
+                timer.restart();
+
+                navigationView->setCurrentIndex(sectionModel->index(row, 0));
+
+                settingsDialog->repaint();
+
+                QApplication::processEvents();
+
+                auto switchTime = elapsedMilliseconds(timer);
+
+                pageSwitchTotal += switchTime;
+                pageSwitchMaximum = qMax(pageSwitchMaximum, switchTime);
+                pageSwitchCount++;
+
+                if (iteration==0) {
+                    pageSwitchTimes.append(switchTime);
+                }
+            }
+        }
+    }
+
+    // theme switching, the theme support signal is emitted directly to simulate the os changing appearance
+
+    auto themeSupport = Nedrysoft::ThemeSupport::ThemeSupport::getInstance();
+    auto isDarkMode = themeSupport->isDarkMode();
+    auto themeSwitchTotal = 0.0;
+
+    for (auto iteration=0;iteration<iterations;iteration++) {
+        isDarkMode = !isDarkMode;
+
+        timer.restart();
+
+        Q_EMIT themeSupport->themeChanged(isDarkMode);
+
+        QApplication::processEvents();
+
+        themeSwitchTotal += elapsedMilliseconds(timer);
+    }
+
+    if (isDarkMode!=themeSupport->isDarkMode()) {
+        Q_EMIT themeSupport->themeChanged(themeSupport->isDarkMode());
+    }
+
+    // accepting settings, every page is modified and the apply button is clicked
+
+    auto acceptTotal = 0.0;
+    QPushButton *applyButton = nullptr;
+
+    for (auto button : settingsDialog->findChildren<QPushButton *>()) {
+        if (button->text()==QObject::tr("Apply")) {
+            applyButton = button;
+        }
+    }
+
+    if (applyButton) {
+        for (auto iteration=0;iteration<iterations;iteration++) {
+            for (auto page : pages) {
+                static_cast<SyntheticSettingsPage *>(page)->modify();
+            }
+
+            // modifications are batched by the dialog, the apply button is enabled once they have been processed
+
+            QApplication::processEvents();
+
+            timer.restart();
+
+            applyButton->click();
+
+            acceptTotal += elapsedMilliseconds(timer);
+        }
+    }
+
+    QJsonObject configuration;
+
+    configuration["pages"] = pageCount;
+    configuration["sections"] = sectionCount;
+    configuration["widgets"] = widgetCount;
+    configuration["iterations"] = iterations;
+    configuration["lazy"] = parser.isSet(lazyOption);
+
+    QJsonObject pageSwitch;
+
+    pageSwitch["mean_ms"] = pageSwitchCount ? pageSwitchTotal/pageSwitchCount : 0.0;
+    pageSwitch["max_ms"] = pageSwitchMaximum;
+    pageSwitch["first_visit_ms"] = pageSwitchTimes;
+
+    QJsonObject results;
+
+    results["configuration"] = configuration;
+    results["constructor_ms"] = constructorTime;
+    results["first_show_ms"] = firstShowTime;
+    results["page_switch"] = pageSwitch;
+    results["theme_switch_ms"] = themeSwitchTotal/iterations;
+    results["accept_settings_ms"] = applyButton ? acceptTotal/iterations : -1.0;
+    results["peak_rss_kb"] = peakResidentSetSize();
+
+    fprintf(stdout, "%s\n", QJsonDocument(results).toJson(QJsonDocument::Compact).constData());
+
+    if ((parser.isSet(traceOption)) && (!settingsDialog->exportTrace(parser.value(traceOption)))) {
+        fprintf(stderr, "unable to write trace to %s\n", qPrintable(parser.value(traceOption)));
+    }
+
+    delete settingsDialog;
+
+    qDeleteAll(pages);
+
+    return 0;
+}
@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of the Nedrysoft SettingsDialog. (https://github.com/nedrysoft/SettingsDialog)
+ *
+ * A cross-platform settings dialog
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DeferredSettingsPage.h"
+
+#include <QJsonArray>
+
+constexpr auto MetaDataKey = "MetaData";
+constexpr auto SettingsPagesKey = "SettingsPages";
+constexpr auto SectionKey = "section";
+constexpr auto CategoryKey = "category";
+constexpr auto DescriptionKey = "description";
+constexpr auto IconKey = "icon";
+constexpr auto DarkIconKey = "darkIcon";
+constexpr auto FactoryKey = "factory";
+constexpr auto KeywordsKey = "keywords";
+
+Nedrysoft::SettingsDialog::DeferredSettingsPage::DeferredSettingsPage(
+        const QString &section,
+        const QString &category,
+        const QString &description,
+        const QString &iconPath,
+        const QString &darkIconPath,
+        const QString &factoryKey,
+        Resolver resolver) :
+
+        m_section(section),
+        m_category(category),
+        m_description(description),
+        m_iconPath(iconPath),
+        m_darkIconPath(darkIconPath),
+        m_factoryKey(factoryKey),
+        m_resolver(resolver),
+        m_isResolved(false) {
+
+}
+
+auto Nedrysoft::SettingsDialog::DeferredSettingsPage::fromMetaData(
+        const QJsonObject &metaData,
+        Resolver resolver) -> QList<Nedrysoft::SettingsDialog::ISettingsPage *> {
+
+    QList<ISettingsPage *> pages;
+
+    auto pluginMetaData = metaData.contains(MetaDataKey) ? metaData[MetaDataKey].toObject() : metaData;
+
+    for (auto value : pluginMetaData[SettingsPagesKey].toArray()) {
+        auto pageMetaData = value.toObject();
+
+        if ((!pageMetaData.contains(SectionKey)) || (!pageMetaData.contains(FactoryKey))) {
+            continue;
+        }
+
+        auto page = new DeferredSettingsPage(
+                pageMetaData[SectionKey].toString(),
+                pageMetaData[CategoryKey].toString(),
+                pageMetaData[DescriptionKey].toString(),
+                pageMetaData[IconKey].toString(),
+                pageMetaData[DarkIconKey].toString(),
+                pageMetaData[FactoryKey].toString(),
+                resolver);
+
+        QStringList keywords;
+
+        for (auto keyword : pageMetaData[KeywordsKey].toArray()) {
+            keywords.append(keyword.toString());
+        }
+
+        page->setKeywords(keywords);
+
+        pages.append(page);
+    }
+
+    return pages;
+}
+
+auto Nedrysoft::SettingsDialog::DeferredSettingsPage::factoryKey() -> QString {
+    return m_factoryKey;
+}
+
+auto Nedrysoft::SettingsDialog::DeferredSettingsPage::isResolved() -> bool {
+    return m_isResolved;
+}
+
+auto Nedrysoft::SettingsDialog::DeferredSettingsPage::resolve() -> Nedrysoft::SettingsDialog::ISettingsPage * {
+    if (m_isResolved) {
+        return m_page;
+    }
+
+    // resolution is only attempted once, a plugin that fails to load is not retried on every call
+
+    m_isResolved = true;
+
+    if (m_resolver) {
+        m_page = m_resolver(m_factoryKey);
+    }
+
+    if (m_page) {
+        connect(
+            m_page.data(),
+            &Nedrysoft::SettingsDialog::ISettingsPage::settingsChanged,
+            this,
+            &Nedrysoft::SettingsDialog::ISettingsPage::settingsChanged
+        );
+    }
+
+    return m_page;
+}
+
+auto Nedrysoft::SettingsDialog::DeferredSettingsPage::setKeywords(const QStringList &keywords) -> void {
+    m_keywords = keywords;
+}
+
+auto Nedrysoft::SettingsDialog::DeferredSettingsPage::section() -> QString {
+    return m_section;
+}
+
+auto Nedrysoft::SettingsDialog::DeferredSettingsPage::category() -> QString {
+    return m_category;
+}
+
+auto Nedrysoft::SettingsDialog::DeferredSettingsPage::description() -> QString {
+    return m_description;
+}
+
+auto Nedrysoft::SettingsDialog::DeferredSettingsPage::icon(bool isDarkMode) -> QIcon {
+    if ((isDarkMode) && (!m_darkIconPath.isEmpty())) {
+        return QIcon(m_darkIconPath);
+    }
+
+    return QIcon(m_iconPath);
+}
+
+auto Nedrysoft::SettingsDialog::DeferredSettingsPage::createWidget() -> QWidget * {
+    auto page = resolve();
+
+    if (!page) {
+        return new QWidget;
+    }
+
+    return page->createWidget();
+}
+
+auto Nedrysoft::SettingsDialog::DeferredSettingsPage::canAcceptSettings() -> bool {
+    if (!m_page) {
+        return true;
+    }
+
+    return m_page->canAcceptSettings();
+}
+
+auto Nedrysoft::SettingsDialog::DeferredSettingsPage::validateSettings() -> Nedrysoft::SettingsDialog::ValidationResult {
+    if (!m_page) {
+        return ValidationResult();
+    }
+
+    return m_page->validateSettings();
+}
+
+auto Nedrysoft::SettingsDialog::DeferredSettingsPage::isThreadSafe() -> bool {
+    if (!m_page) {
+        return true;
+    }
+
+    return m_page->isThreadSafe();
+}
+
+auto Nedrysoft::SettingsDialog::DeferredSettingsPage::acceptSettings() -> void {
+    if (m_page) {
+        m_page->acceptSettings();
+    }
+}
+
+auto Nedrysoft::SettingsDialog::DeferredSettingsPage::acceptSettingsAsync() -> QFuture<void> {
+    if (m_page) {
+        return m_page->acceptSettingsAsync();
+    }
+
+    return ISettingsPage::acceptSettingsAsync();
+}
+
+auto Nedrysoft::SettingsDialog::DeferredSettingsPage::isIndependent() -> bool {
+    if (!m_page) {
+        return true;
+    }
+
+    return m_page->isIndependent();
+}
+
+auto Nedrysoft::SettingsDialog::DeferredSettingsPage::reloadSettings() -> bool {
+    // a page that has not been loaded has no widget, so there are no edits to discard
+
+    if (!m_page) {
+        return true;
+    }
+
+    return m_page->reloadSettings();
+}
+
+auto Nedrysoft::SettingsDialog::DeferredSettingsPage::saveState() -> QVariant {
+    if (!m_page) {
+        return QVariant();
+    }
+
+    return m_page->saveState();
+}
+
+auto Nedrysoft::SettingsDialog::DeferredSettingsPage::restoreState(const QVariant &state) -> void {
+    if (m_page) {
+        m_page->restoreState(state);
+    }
+}
+
+auto Nedrysoft::SettingsDialog::DeferredSettingsPage::memoryUsage() -> qint64 {
+    if (!m_page) {
+        return -1;
+    }
+
+    return m_page->memoryUsage();
+}
+
+auto Nedrysoft::SettingsDialog::DeferredSettingsPage::keywords() -> QStringList {
+    // the keywords come from the metadata so that searching does not resolve the page
+
+    return m_keywords;
+}
+
+auto Nedrysoft::SettingsDialog::DeferredSettingsPage::snapshotSettings() -> QVariantMap {
+    if (!m_page) {
+        return QVariantMap();
+    }
+
+    return m_page->snapshotSettings();
+}
+
+auto Nedrysoft::SettingsDialog::DeferredSettingsPage::rollbackSettings(const QVariantMap &values) -> void {
+    if (m_page) {
+        m_page->rollbackSettings(values);
+    }
+}
+
+auto Nedrysoft::SettingsDialog::DeferredSettingsPage::commitSettings(const QVariantMap &changes) -> void {
+    if (m_page) {
+        m_page->commitSettings(changes);
+    }
+}
+
+auto Nedrysoft::SettingsDialog::DeferredSettingsPage::commitSettingsAsync(const QVariantMap &changes) -> QFuture<void> {
+    if (m_page) {
+        return m_page->commitSettingsAsync(changes);
+    }
+
+    return ISettingsPage::commitSettingsAsync(changes);
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of the Nedrysoft SettingsDialog. (https://github.com/nedrysoft/SettingsDialog)
+ *
+ * A cross-platform settings dialog
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NEDRYSOFT_DEFERREDSETTINGSPAGE_H
+#define NEDRYSOFT_DEFERREDSETTINGSPAGE_H
+
+#include "ISettingsPage.h"
+#include "SettingsDialogSpec.h"
+
+#include <QJsonObject>
+#include <QList>
+#include <QPointer>
+#include <QString>
+#include <functional>
+
+namespace Nedrysoft { namespace SettingsDialog {
+    /**
+     * @brief       The DeferredSettingsPage class is a settings page that is described by static metadata.
+     *
+     * @details     The section, category, description and icon are supplied from metadata (i.e the JSON metadata
+     *              of a plugin) so that the page can be listed in the dialog without loading the plugin.  The real
+     *              page is resolved through the factory key the first time its widget is created, so the dialog
+     *              should be constructed with SettingsDialog::LazyPages.
+     *
+     *              The metadata for a plugin is read from a "SettingsPages" array, each entry is an object with
+     *              the keys "section", "category", "description", "icon", "darkIcon" (optional), "keywords"
+     *              (optional array of strings) and "factory".
+     */
+    class SETTINGS_DIALOG_DLLSPEC DeferredSettingsPage :
+            public Nedrysoft::SettingsDialog::ISettingsPage {
+
+        private:
+            Q_OBJECT
+
+        public:
+            /**
+             * @brief       The resolver is called with the factory key and returns the real page.
+             *
+             * @note        The resolver retains ownership of the returned page.
+             */
+            using Resolver = std::function<ISettingsPage *(const QString &factoryKey)>;
+
+        public:
+            /**
+             * @brief       Constructs a new DeferredSettingsPage.
+             *
+             * @param[in]   section the section name.
+             * @param[in]   category the category name.
+             * @param[in]   description the description.
+             * @param[in]   iconPath the path of the light mode icon.
+             * @param[in]   darkIconPath the path of the dark mode icon, if empty the light mode icon is used.
+             * @param[in]   factoryKey the key passed to the resolver.
+             * @param[in]   resolver the function that loads and returns the real page.
+             */
+            DeferredSettingsPage(
+                    const QString &section,
+                    const QString &category,
+                    const QString &description,
+                    const QString &iconPath,
+                    const QString &darkIconPath,
+                    const QString &factoryKey,
+                    Resolver resolver);
+
+            /**
+             * @brief       Creates the pages described by plugin metadata.
+             *
+             * @note        The metadata may be the object returned by QPluginLoader::metaData() or the contents of
+             *              its "MetaData" key.  The caller takes ownership of the returned pages.
+             *
+             * @param[in]   metaData the plugin metadata.
+             * @param[in]   resolver the function that loads and returns the real page.
+             *
+             * @returns     the list of pages.
+             */
+            static auto fromMetaData(const QJsonObject &metaData, Resolver resolver) -> QList<ISettingsPage *>;
+
+            /**
+             * @brief       Returns the factory key that identifies the real page.
+             *
+             * @returns     the factory key.
+             */
+            auto factoryKey() -> QString;
+
+            /**
+             * @brief       Returns whether the real page has been resolved.
+             *
+             * @returns     true if resolved; otherwise false.
+             */
+            auto isResolved() -> bool;
+
+            /**
+             * @brief       Returns the real page, resolving it if required.
+             *
+             * @returns     the real page; or nullptr if it could not be resolved.
+             */
+            auto resolve() -> ISettingsPage *;
+
+            /**
+             * @brief       Sets the keywords that the page can be found by when searching the dialog.
+             *
+             * @param[in]   keywords the list of keywords.
+             */
+            auto setKeywords(const QStringList &keywords) -> void;
+
+        public:
+            auto section() -> QString override;
+            auto category() -> QString override;
+            auto description() -> QString override;
+            auto icon(bool isDarkMode) -> QIcon override;
+            auto createWidget() -> QWidget * override;
+            auto canAcceptSettings() -> bool override;
+            auto validateSettings() -> ValidationResult override;
+            auto isThreadSafe() -> bool override;
+            auto acceptSettings() -> void override;
+            auto acceptSettingsAsync() -> QFuture<void> override;
+            auto isIndependent() -> bool override;
+            auto reloadSettings() -> bool override;
+            auto saveState() -> QVariant override;
+            auto restoreState(const QVariant &state) -> void override;
+            auto memoryUsage() -> qint64 override;
+            auto keywords() -> QStringList override;
+            auto snapshotSettings() -> QVariantMap override;
+            auto rollbackSettings(const QVariantMap &values) -> void override;
+            auto commitSettings(const QVariantMap &changes) -> void override;
+            auto commitSettingsAsync(const QVariantMap &changes) -> QFuture<void> override;
+
+        private:
+            //! @cond
+
+            QString m_section;
+            QString m_category;
+            QString m_description;
+            QString m_iconPath;
+            QString m_darkIconPath;
+            QString m_factoryKey;
+            QStringList m_keywords;
+            Resolver m_resolver;
+            QPointer<ISettingsPage> m_page;
+            bool m_isResolved;
+
+            //! @endcond
+    };
+}}
+
+#endif // NEDRYSOFT_DEFERREDSETTINGSPAGE_H
@@ -27,8 +27,44 @@
 #include "SettingsDialogSpec.h"
 
 #include <IInterface>
+#include <QFuture>
+#include <QFutureInterface>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVariantMap>
 
 namespace Nedrysoft { namespace SettingsDialog {
+    class ISettingsPage;
+
+    /**
+     * @brief       The ValidationResult class holds the result of validating a settings page.
+     */
+    class ValidationResult {
+        public:
+            /**
+             * @brief       Constructs a new ValidationResult.
+             *
+             * @param[in]   isValid true if the settings are valid; otherwise false.
+             * @param[in]   message the message to display to the user if the settings are invalid.
+             */
+            ValidationResult(bool isValid=true, const QString &message=QString()) :
+                m_isValid(isValid),
+                m_message(message),
+                m_page(nullptr) {
+
+                }
+
+        public:
+            //! @cond
+
+            bool m_isValid;
+            QString m_message;
+            ISettingsPage *m_page;
+
+            //! @endcond
+    };
+
     /**
      * @brief       The Settings Page class defines a settings page.
      */
@@ -74,6 +110,10 @@ namespace Nedrysoft { namespace SettingsDialog {
             /**
              * @brief       Creates a new instance of the page widget.
              *
+             * @details     A page that returns a valid state from saveState() may have its widget destroyed by the
+             *              dialog and this called again, the page must then use the new widget in place of the
+             *              previous one.  Other pages are asked for their widget once.
+             *
              * @returns     the new widget instance.
              */
             virtual auto createWidget() -> QWidget * = 0;
@@ -85,11 +125,189 @@ namespace Nedrysoft { namespace SettingsDialog {
              */
             virtual auto canAcceptSettings() -> bool = 0;
 
+            /**
+             * @brief       Validates the settings and describes the problem if they cannot be applied.
+             *
+             * @note        The default implementation calls canAcceptSettings().
+             *
+             * @returns     the validation result.
+             */
+            virtual auto validateSettings() -> ValidationResult {
+                return ValidationResult(canAcceptSettings());
+            }
+
+            /**
+             * @brief       Returns whether validateSettings() can be called from a worker thread.
+             *
+             * @details     Thread safe pages are validated concurrently, the implementation must not access
+             *              widgets from validateSettings().
+             *
+             * @returns     true if validation is thread safe; otherwise false.
+             */
+            virtual auto isThreadSafe() -> bool {
+                return false;
+            }
+
             /**
              * @brief       Applies the current settings.
              */
             virtual auto acceptSettings() -> void = 0;
 
+            /**
+             * @brief       Applies the current settings asynchronously.
+             *
+             * @details     Used by the dialog when constructed with SettingsDialog::AsyncApply.  Pages that perform
+             *              slow work (i.e disk or network) should reimplement this and return a future that completes
+             *              when the settings have been applied, the future should honour cancellation.  This is
+             *              called on the GUI thread, the page must read the values from its widgets before starting
+             *              the background work, which must not access the widgets.  The default implementation calls
+             *              acceptSettings() and returns a finished future.
+             *
+             * @returns     the future for the apply operation.
+             */
+            virtual auto acceptSettingsAsync() -> QFuture<void> {
+                acceptSettings();
+
+                QFutureInterface<void> futureInterface;
+
+                futureInterface.reportStarted();
+                futureInterface.reportFinished();
+
+                return futureInterface.future();
+            }
+
+            /**
+             * @brief       Returns whether the settings can be applied at the same time as other pages.
+             *
+             * @details     Independent pages are applied concurrently during an asynchronous apply, all other pages
+             *              are applied one after another in the order they appear in the dialog.
+             *
+             * @returns     true if the page is independent of other pages; otherwise false.
+             */
+            virtual auto isIndependent() -> bool {
+                return false;
+            }
+
+            /**
+             * @brief       Refreshes the page widget from the current settings.
+             *
+             * @details     Called when a dialog that was kept alive is shown again, any unapplied edits should be
+             *              discarded.  A page that does not refresh its widget remains modified, so its edits can
+             *              still be applied.  The default implementation does nothing and returns false.
+             *
+             * @returns     true if the page widget was refreshed; otherwise false.
+             */
+            virtual auto reloadSettings() -> bool {
+                return false;
+            }
+
+            /**
+             * @brief       Saves the state of the page widget before it is destroyed.
+             *
+             * @details     Called when the dialog releases a hidden page widget to stay within its memory budget.
+             *              A page is only released if this returns a valid state, the widget is then destroyed and
+             *              createWidget() is called when the page is next shown.  The default implementation
+             *              returns an invalid QVariant, so the widget is never released.
+             *
+             * @returns     the state of the widget, including any unapplied changes.
+             */
+            virtual auto saveState() -> QVariant {
+                return QVariant();
+            }
+
+            /**
+             * @brief       Restores the state of the page widget after it has been created again.
+             *
+             * @param[in]   state the state returned by saveState().
+             */
+            virtual auto restoreState(const QVariant &state) -> void {
+                Q_UNUSED(state)
+            }
+
+            /**
+             * @brief       Returns the estimated memory used by the page widget.
+             *
+             * @note        The default implementation returns -1, the dialog then estimates the usage from the
+             *              number of widgets in the page.
+             *
+             * @returns     the estimated memory usage in kilobytes; or -1 if unknown.
+             */
+            virtual auto memoryUsage() -> qint64 {
+                return -1;
+            }
+
+            /**
+             * @brief       Returns the current values of the settings shown by the page.
+             *
+             * @details     A page that returns values is transactional.  The dialog records the values when the
+             *              page widget is created and after each apply, Cancel then restores the recorded values
+             *              through rollbackSettings() and Apply passes only the values that differ to
+             *              commitSettings().  The values should be read from the page widget without any I/O.  The
+             *              default implementation returns an empty map.
+             *
+             * @returns     the values keyed by setting name.
+             */
+            virtual auto snapshotSettings() -> QVariantMap {
+                return QVariantMap();
+            }
+
+            /**
+             * @brief       Restores the page widget to previously recorded values, discarding any edits.
+             *
+             * @param[in]   values the values returned by snapshotSettings() when they were recorded.
+             */
+            virtual auto rollbackSettings(const QVariantMap &values) -> void {
+                Q_UNUSED(values)
+            }
+
+            /**
+             * @brief       Applies the values that have changed since they were last recorded.
+             *
+             * @note        The default implementation calls acceptSettings().
+             *
+             * @param[in]   changes the changed values keyed by setting name.
+             */
+            virtual auto commitSettings(const QVariantMap &changes) -> void {
+                Q_UNUSED(changes)
+
+                acceptSettings();
+            }
+
+            /**
+             * @brief       Applies the values that have changed since they were last recorded asynchronously.
+             *
+             * @details     Used instead of acceptSettingsAsync() for transactional pages when the dialog is
+             *              constructed with SettingsDialog::AsyncApply, the same threading rules apply.  The default
+             *              implementation calls commitSettings() and returns a finished future.
+             *
+             * @param[in]   changes the changed values keyed by setting name.
+             *
+             * @returns     the future for the apply operation.
+             */
+            virtual auto commitSettingsAsync(const QVariantMap &changes) -> QFuture<void> {
+                commitSettings(changes);
+
+                QFutureInterface<void> futureInterface;
+
+                futureInterface.reportStarted();
+                futureInterface.reportFinished();
+
+                return futureInterface.future();
+            }
+
+            /**
+             * @brief       Returns additional words that the page can be found by when searching the dialog.
+             *
+             * @details     The section, category and description are always searched, keywords should name the
+             *              individual settings on the page.  This is called when the page is added, so it must not
+             *              depend on the page widget.  The default implementation returns an empty list.
+             *
+             * @returns     the list of keywords.
+             */
+            virtual auto keywords() -> QStringList {
+                return QStringList();
+            }
+
             /**
              * @brief       Emitted when the pages settings have changed.
              */
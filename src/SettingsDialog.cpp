@@ -25,14 +25,24 @@
 
 #include "ISettingsPage.h"
 #include "SeparatorWidget.h"
+#include "SettingsIconCache.h"
+#include "SettingsSearchIndex.h"
+#include "SettingsTracer.h"
+#include "SettingsSectionModel.h"
+#include "SettingsSnapshot.h"
+#include "SettingsStore.h"
 #if defined(Q_OS_MACOS)
 #include "TransparentWidget.h"
 #endif
 
 #include <QApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMessageBox>
 #include <QResizeEvent>
 #include <QScreen>
-#include <QTreeWidget>
+#include <QThreadPool>
+#include <QTimer>
 #include <QVBoxLayout>
 #include <ThemeSupport>
 
@@ -46,10 +56,16 @@
 #include <memory>
 #else
 #include <QLabel>
+#include <QLineEdit>
+#include <QListView>
+#include <QProgressBar>
 #include <QPushButton>
 #include <QStackedWidget>
+#include <QTabWidget>
 #endif
 
+#include <algorithm>
+
 #if defined(Q_OS_MACOS)
 using namespace std::chrono_literals;
 
@@ -60,13 +76,19 @@ constexpr auto AlphaOpaque = 1;
 constexpr auto DefaultMinimumWidth = 300;
 #else
 constexpr auto CategoryFontAdjustment = 6;
-constexpr auto SettingsIconSize = 32;
 constexpr auto SettingsDialogScaleFactor = 0.5;
 constexpr auto CategoryLeftMargin = 4;
 constexpr auto CategoryBottomMargin = 9;
 constexpr auto DetailsLeftMargin = 9;
+constexpr auto CompactSectionName = "compactSection";
 #endif
 
+constexpr auto SettingsIconSize = 32;
+constexpr auto DefaultBuildSliceBudget = 8;
+constexpr auto EstimatedWidgetMemoryUsage = 2;
+constexpr auto DefaultPrefetchBudget = 8;
+constexpr auto PrefetchIdleDelay = 250;
+
 constexpr auto ThemeStylesheet = R"(
     QStackedWidget {
         [base-background-colour];
@@ -91,20 +113,61 @@ constexpr auto ThemeStylesheet = R"(
     QTabBar::tab:!selected {
         [base-background-colour];
     }
-)";
 
-constexpr auto ThemeSubStylesheet = R"(
-    QStackedWidget {
+    QTabWidget QStackedWidget {
+        [background-colour];
+    }
+
+    QStackedWidget > .QWidget#compactSection {
         [background-colour];
     }
 )";
 
 Nedrysoft::SettingsDialog::SettingsDialog::SettingsDialog(const QList<Nedrysoft::SettingsDialog::ISettingsPage *> &pages, QWidget *parent) :
+        SettingsDialog(pages, NoOptions, parent) {
+
+}
+
+Nedrysoft::SettingsDialog::SettingsDialog::SettingsDialog(
+        const QList<Nedrysoft::SettingsDialog::ISettingsPage *> &pages,
+        Options options,
+        QWidget *parent) :
+
         QWidget(nullptr),
-        m_currentPage(nullptr) {
+#if !defined(Q_OS_MACOS)
+        m_searchIndex(new SettingsSearchIndex),
+        m_currentSection(nullptr),
+        m_navigationWidth(0),
+        m_memoryUsage(0),
+        m_memoryBudget(0),
+        m_prefetchBudget(DefaultPrefetchBudget),
+        m_isPrefetchScheduled(false),
+#endif
+        m_currentPage(nullptr),
+        m_options(options),
+        m_buildSliceBudget(DefaultBuildSliceBudget),
+        m_isClosed(false),
+        m_modifiedTimer(new QTimer(this)),
+        m_validationPool(new QThreadPool(this)),
+        m_iconCache(new SettingsIconCache),
+        m_tracer((options & Tracing) ? new SettingsTracer : nullptr),
+        m_pageSwitchWidget(nullptr),
+        m_pageSwitchPage(nullptr),
+        m_pageSwitchStart(0),
+        m_snapshot(new SettingsSnapshot),
+        m_settingsStore(nullptr) {
 
     Q_UNUSED(parent)
 
+    m_iconCache->setTracer(m_tracer);
+
+    m_modifiedTimer->setSingleShot(true);
+    m_modifiedTimer->setInterval(0);
+
+    connect(m_modifiedTimer, &QTimer::timeout, [=]() {
+        processModifiedPages();
+    });
+
     auto themeSupport = Nedrysoft::ThemeSupport::ThemeSupport::getInstance();
 
     auto themeChangedSignal = connect(
@@ -112,17 +175,32 @@ Nedrysoft::SettingsDialog::SettingsDialog::SettingsDialog(const QList<Nedrysoft:
         &Nedrysoft::ThemeSupport::ThemeSupport::themeChanged,
         [=](bool isDarkMode) {
 
-            setStyleSheet(updateStyleSheet(ThemeStylesheet, isDarkMode));
+            auto start = m_tracer ? m_tracer->timestamp() : 0;
 
-#if defined(Q_OS_MACOS)
+            // the section tab widgets are styled by the dialog stylesheet, so the re-polish happens once from here
+
+            setStyleSheet(themeStyleSheet(isDarkMode));
+
+#if !defined(Q_OS_MACOS)
+            // the model rows fetch their icon when they are next painted, so only visible rows pay for the change
+
+            m_sectionModel->setDarkMode(isDarkMode);
+#else
             for(auto settingsPage : m_pages) {
                 if (!settingsPage->m_pageSettings.isEmpty()) {
-                    settingsPage->m_toolbarItem->setIcon(settingsPage->m_pageSettings[0]->icon(isDarkMode));
+                    settingsPage->m_toolbarItem->setIcon(m_iconCache->icon(
+                            settingsPage->m_pageSettings[0],
+                            SettingsIconSize,
+                            isDarkMode,
+                            devicePixelRatioF()));
                 }
             }
 
             updateTitlebar();
 #endif
+            if (m_tracer) {
+                m_tracer->record("themeChanged", nullptr, start);
+            }
         }
     );
 
@@ -130,28 +208,59 @@ Nedrysoft::SettingsDialog::SettingsDialog::SettingsDialog(const QList<Nedrysoft:
         themeSupport->disconnect(themeChangedSignal);
     });
 
-    setStyleSheet(updateStyleSheet(ThemeStylesheet, themeSupport->isDarkMode()));
+    setStyleSheet(themeStyleSheet(themeSupport->isDarkMode()));
 
 #if defined(Q_OS_MACOS)
     m_toolbar = new Nedrysoft::MacHelper::MacToolbar;
 
     m_animationGroup = nullptr;
+    m_maximumWidth = DefaultMinimumWidth;
 #else
     resize((QSizeF(parent->frameSize())*SettingsDialogScaleFactor).toSize());
 
     m_mainLayout = new QHBoxLayout;
 
-    m_treeWidget = new QTreeWidget(this);
+    m_navigationView = new QListView(this);
+
+    m_navigationView->setIconSize(QSize(SettingsIconSize, SettingsIconSize));
+
+    m_navigationView->setUniformItemSizes(true);
+
+    m_navigationView->setEditTriggers(QListView::NoEditTriggers);
+
+    m_navigationView->setSelectionBehavior(QListView::SelectRows);
+
+    m_navigationView->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+
+    // the model reads the section list directly, so a row is the index of the section in the list
 
-    m_treeWidget->setIndentation(0);
+    m_sectionModel = new SettingsSectionModel(m_sectionList, m_iconCache, themeSupport->isDarkMode(), m_navigationView);
 
-    m_treeWidget->setIconSize(QSize(SettingsIconSize, SettingsIconSize));
+    m_navigationView->setModel(m_sectionModel);
 
-    m_treeWidget->setHeaderHidden(true);
+    connect(m_navigationView->selectionModel(), &QItemSelectionModel::currentChanged, [=](const QModelIndex &current, const QModelIndex &previous) {
+        Q_UNUSED(previous)
 
-    m_treeWidget->setSelectionBehavior(QTreeWidget::SelectRows);
+        auto section = m_sectionList.value(current.row(), nullptr);
 
-    m_treeWidget->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+        if (section) {
+            selectSection(section);
+        }
+    });
+
+    if (m_options & Prefetch) {
+        // hovering over a section is a strong hint that it will be selected next
+
+        m_navigationView->setMouseTracking(true);
+
+        connect(m_navigationView, &QListView::entered, [=](const QModelIndex &index) {
+            auto section = m_sectionList.value(index.row(), nullptr);
+
+            if (section) {
+                prefetchSection(section, true);
+            }
+        });
+    }
 
     m_stackedWidget = new QStackedWidget;
 
@@ -159,7 +268,21 @@ Nedrysoft::SettingsDialog::SettingsDialog::SettingsDialog(const QList<Nedrysoft:
 
     m_stackedWidget->layout()->setContentsMargins(0, 0, 0, 0);
 
-    m_mainLayout->addWidget(m_treeWidget);
+    m_searchField = new QLineEdit;
+
+    m_searchField->setPlaceholderText(tr("Search"));
+    m_searchField->setClearButtonEnabled(true);
+
+    connect(m_searchField, &QLineEdit::textChanged, [=](const QString &text) {
+        filterSections(text);
+    });
+
+    m_navigationLayout = new QVBoxLayout;
+
+    m_navigationLayout->addWidget(m_searchField);
+    m_navigationLayout->addWidget(m_navigationView);
+
+    m_mainLayout->addLayout(m_navigationLayout);
 
     m_categoryLabel = new QLabel;
 
@@ -196,19 +319,49 @@ Nedrysoft::SettingsDialog::SettingsDialog::SettingsDialog(const QList<Nedrysoft:
 
     m_applyButton->setDisabled(true);
 
+    m_applyProgress = new QProgressBar;
+
+    m_applyProgress->setTextVisible(false);
+    m_applyProgress->setVisible(false);
+
+    m_applyCancelled = false;
+    m_closeAfterApply = false;
+
     connect(m_okButton, &QPushButton::clicked, [=](bool /*checked*/) {
-        acceptSettings();
-        close();
+        if (m_options & AsyncApply) {
+            startApply(true);
+
+            return;
+        }
+
+        if (acceptSettings()) {
+            close();
+        }
     });
 
     connect(m_applyButton, &QPushButton::clicked, [=](bool /*checked*/) {
+        if (m_options & AsyncApply) {
+            startApply(false);
+
+            return;
+        }
+
         acceptSettings();
     });
 
     connect(m_cancelButton, &QPushButton::clicked, [=](bool /*checked*/) {
+        if (isApplying()) {
+            cancelApply();
+
+            return;
+        }
+
+        revertSettings();
+
         close();
     });
 
+    m_controlsLayout->addWidget(m_applyProgress);
     m_controlsLayout->addWidget(m_okButton);
     m_controlsLayout->addWidget(m_cancelButton);
     m_controlsLayout->addWidget(m_applyButton);
@@ -218,43 +371,68 @@ Nedrysoft::SettingsDialog::SettingsDialog::SettingsDialog(const QList<Nedrysoft:
     setLayout(m_layout);
 #endif
 
-    for (auto page: pages) {
-#if defined(Q_OS_MACOS)
-        auto settingsPage = addPage(page);
+#if !defined(Q_OS_MACOS)
+    if ((m_options & IncrementalBuild) && (!pages.isEmpty())) {
+        // the first section is built now so that the dialog can be shown, the remaining pages are built in
+        // slices from the event loop
 
-        m_pages[settingsPage->m_toolbarItem] = settingsPage;
-#else
-        connect(page, &Nedrysoft::SettingsDialog::ISettingsPage::settingsChanged, [=]() {
-            m_applyButton->setDisabled(false);
-        });
+        auto firstSectionId = describePage(pages.first()).m_sectionId;
 
-        auto settingsPage = addPage(page);
+        QList<ISettingsPage *> firstPages;
 
-        m_pages.append(settingsPage);
-#endif
-    }
+        for (auto page : pages) {
+            if (describePage(page).m_sectionId==firstSectionId) {
+                firstPages.append(page);
+            } else {
+                m_pendingPages.append(page);
+            }
+        }
 
-#if defined(Q_OS_MACOS)
-    m_toolbar->enablePreferencesToolbar();
+        addPages(firstPages);
+
+        if (!m_pendingPages.isEmpty()) {
+            QTimer::singleShot(0, this, [=]() {
+                buildNextSlice();
+            });
+        }
+    } else {
+        addPages(pages);
+    }
+#else
+    addPages(pages);
 #endif
 
 #if !defined(Q_OS_MACOS)
-    int listWidth = 0;
+    m_currentSection = m_sectionList.value(0, nullptr);
+
+    if (m_currentSection) {
+        // sections that gained a tab widget were moved to the end of the stack, so the first is selected explicitly
+
+        m_stackedWidget->setCurrentWidget(m_currentSection->m_widget);
+        m_categoryLabel->setText(m_currentSection->m_name);
 
-    for (auto currentIndex=0;currentIndex<m_treeWidget->topLevelItemCount();currentIndex++) {
-        auto item = m_treeWidget->topLevelItem(currentIndex);
+        // the view is pointed at the section that is already shown, so selecting it does not switch pages
 
-        auto fontMetrics = QFontMetrics(m_treeWidget->font());
+        m_navigationView->setCurrentIndex(m_sectionModel->index(m_currentSection->m_index));
+    }
+
+    if ((m_options & LazyPages) && (m_currentSection)) {
+        // only the page that is initially visible is created, the remainder are created when they are selected
 
-        auto width = fontMetrics.boundingRect(item->text(0)).width();
+        auto settingsPage = sectionPage(m_currentSection);
 
-        if (width>listWidth) {
-            listWidth = width;
+        if (settingsPage) {
+            createPageWidget(settingsPage);
         }
     }
+#endif
+
+#if defined(Q_OS_MACOS)
+    m_toolbar->enablePreferencesToolbar();
+#endif
 
-    m_treeWidget->setMinimumWidth(listWidth+(SettingsIconSize*2));
-    m_treeWidget->setMaximumWidth(listWidth+(SettingsIconSize*2));
+#if !defined(Q_OS_MACOS)
+    updateNavigationWidth();
 #endif
 
 #if defined(Q_OS_MACOS)
@@ -274,6 +452,8 @@ Nedrysoft::SettingsDialog::SettingsDialog::SettingsDialog(const QList<Nedrysoft:
     if (m_pages.first()) {
         m_currentPage = m_pages.first();
 
+        createPageWidget(m_currentPage);
+
         m_currentPage->m_widget->setOpacity(1);
 
         setMinimumSize(QSize(m_maximumWidth, m_currentPage->m_widget->sizeHint().height()));
@@ -340,16 +520,24 @@ auto Nedrysoft::SettingsDialog::SettingsDialog::sizeHint() -> QSize {
 }
 
 Nedrysoft::SettingsDialog::SettingsDialog::~SettingsDialog() {
+    delete m_iconCache;
+    delete m_tracer;
+    delete m_snapshot;
+
 #if defined(Q_OS_MACOS)
     delete m_toolbar;
 #else
     for (auto page : m_pages) {
-        disconnect(page->m_pageSettings, 0, 0, 0);
+        disconnect(page->m_pageSettings, nullptr, this, nullptr);
 
         delete page;
     }
+
+    qDeleteAll(m_sections);
+
+    delete m_searchIndex;
     delete m_layout;
-    delete m_treeWidget;
+    delete m_navigationView;
     delete m_categoryLabel;
     delete m_stackedWidget;
 #endif
@@ -357,319 +545,1625 @@ Nedrysoft::SettingsDialog::SettingsDialog::~SettingsDialog() {
 
 auto Nedrysoft::SettingsDialog::SettingsDialog::okToClose() -> bool {
 #if !defined(Q_OS_MACOS)
-    for(auto page : m_pages) {
-        if (!page->m_pageSettings->canAcceptSettings()) {
-
-            return false;
-        }
+    if (isApplying()) {
+        return false;
     }
-#endif
+
+    return validatePages(dirtyPages());
+#else
     return true;
+#endif
 }
 
 auto Nedrysoft::SettingsDialog::SettingsDialog::resizeEvent(QResizeEvent *event) -> void {
-    for(auto page : m_pages) {
-        if (page->m_widget) {
-#if defined(Q_OS_MACOS)
-            page->m_widget->resize((event->size()));
-#else
-            // resizing needs to account for the category label & margins
+    Q_UNUSED(event)
 
-            auto margins = m_layout->contentsMargins();
+    // only the visible page is resized, hidden pages are resized when they are next shown
 
-            auto adjustment = margins.bottom()+m_categoryLabel->height()+m_layout->spacing();
+    auto currentPage = visiblePage();
 
-            page->m_widget->resize(m_stackedWidget->size()-QSize(margins.right(), adjustment));
-#endif
+    for(auto page : m_pages) {
+        if (page!=currentPage) {
+            page->m_needsResize = true;
         }
     }
-}
-
-auto Nedrysoft::SettingsDialog::SettingsDialog::nativeWindowHandle() -> QWindow * {
-    //
-    // @note the call to winId() is required as it sets up windowHandle() to return the correct value,
-    //       failing to call this will result in windowHandle not returning the correct value.
-
-    window()->winId();
 
-    return window()->windowHandle();
+    if (currentPage) {
+        resizePage(currentPage);
+    }
 }
 
-auto Nedrysoft::SettingsDialog::SettingsDialog::addPage(ISettingsPage *page) -> Nedrysoft::SettingsDialog::SettingsPage * {
-    auto themeSupport = Nedrysoft::ThemeSupport::ThemeSupport::getInstance();
-
+auto Nedrysoft::SettingsDialog::SettingsDialog::visiblePage() -> Nedrysoft::SettingsDialog::SettingsPage * {
 #if defined(Q_OS_MACOS)
-    TransparentWidget *widgetContainer = nullptr;
-    SettingsPage *settingsPage = nullptr;
-
-    for(auto currentPage : m_pages) {
-        if (currentPage->m_name==page->section()) {
-            widgetContainer = currentPage->m_widget;
-            settingsPage = currentPage;
-
-            break;
-        }
+    return m_currentPage;
+#else
+    if (!m_currentSection) {
+        return nullptr;
     }
 
-    if (!widgetContainer) {
-        widgetContainer = new TransparentWidget(0, this);
-    }
+    return sectionPage(m_currentSection);
+#endif
+}
 
-    if (widgetContainer->count()) {
-        widgetContainer->addWidget(new SeparatorWidget);
+auto Nedrysoft::SettingsDialog::SettingsDialog::beginPageSwitch(SettingsPage *settingsPage) -> void {
+    if (m_pageSwitchWidget) {
+        m_pageSwitchWidget->removeEventFilter(this);
     }
 
-    auto pageWidget = page->createWidget();
-
-    widgetContainer->addWidget(pageWidget);
+    // the placeholder lives as long as the dialog, so it is watched rather than the page widget itself
 
-    if (settingsPage) {
 #if defined(Q_OS_MACOS)
-        settingsPage->m_pageSettings.append(page);
+    m_pageSwitchWidget = settingsPage->m_widget;
+    m_pageSwitchPage = settingsPage->m_pageSettings.isEmpty() ? nullptr : settingsPage->m_pageSettings.first();
+#else
+    m_pageSwitchWidget = settingsPage->m_container;
+    m_pageSwitchPage = settingsPage->m_pageSettings;
 #endif
-        return settingsPage;
+    m_pageSwitchStart = m_tracer->timestamp();
+
+    m_pageSwitchWidget->installEventFilter(this);
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::eventFilter(QObject *watched, QEvent *event) -> bool {
+    if ((event->type()==QEvent::Paint) && (watched==m_pageSwitchWidget)) {
+        m_pageSwitchWidget->removeEventFilter(this);
+
+        m_tracer->record("pageSwitch", m_pageSwitchPage, m_pageSwitchStart);
+
+        m_pageSwitchWidget = nullptr;
+        m_pageSwitchPage = nullptr;
     }
 
-    settingsPage = new SettingsPage;
+    return QWidget::eventFilter(watched, event);
+}
 
-    settingsPage->m_name = page->section();
-    settingsPage->m_widget = widgetContainer;
+auto Nedrysoft::SettingsDialog::SettingsDialog::setSearchText(const QString &text) -> void {
 #if defined(Q_OS_MACOS)
-    settingsPage->m_pageSettings.append(page);
+    Q_UNUSED(text)
 #else
-    settingsPage->m_pageSettings = page;
+    m_searchField->setText(text);
 #endif
-    settingsPage->m_icon = page->icon(themeSupport->isDarkMode());
-    settingsPage->m_description = page->description();
+}
 
-    if (pageWidget->layout()) {
-        pageWidget->layout()->setSizeConstraint(QLayout::SetMinimumSize);
+auto Nedrysoft::SettingsDialog::SettingsDialog::traceEvents() -> QVector<TraceEvent> {
+    if (!m_tracer) {
+        return QVector<TraceEvent>();
     }
 
-    settingsPage->m_toolbarItem = m_toolbar->addItem(
-            page->icon(themeSupport->isDarkMode()),
-            page->section());
-
-    connect(settingsPage->m_toolbarItem,
-            &Nedrysoft::MacHelper::MacToolbarItem::activated,
-            this,
-            [this, settingsPage]() {
-
-        if (!m_currentPage) {
-            m_currentPage = settingsPage;
-            m_currentPage->m_widget->setOpacity(1);
+    return m_tracer->events();
+}
 
-            resize(m_currentPage->m_widget->sizeHint());
+auto Nedrysoft::SettingsDialog::SettingsDialog::clearTraceEvents() -> void {
+    if (m_tracer) {
+        m_tracer->clear();
+    }
+}
 
-            this->setWindowTitle(settingsPage->m_name);
+auto Nedrysoft::SettingsDialog::SettingsDialog::exportTrace(const QString &filename) -> bool {
+    if (!m_tracer) {
+        return false;
+    }
 
-            return;
-        }
+    QFile file(filename);
 
-        auto currentItem = m_pages[m_currentPage->m_toolbarItem]->m_widget;
-        auto nextItem = settingsPage->m_widget;
+    if (!file.open(QFile::WriteOnly | QFile::Truncate)) {
+        return false;
+    }
 
-        if (currentItem==nextItem) {
-            return;
-        }
+    auto trace = m_tracer->toChromeTrace();
 
-        if (m_animationGroup) {
-            m_animationGroup->stop();
-            m_animationGroup->deleteLater();
-        }
+    return file.write(trace)==trace.size();
+}
 
-        m_animationGroup = new QParallelAnimationGroup;
+auto Nedrysoft::SettingsDialog::SettingsDialog::resizePage(SettingsPage *settingsPage) -> void {
+    if (!settingsPage->m_widget) {
+        return;
+    }
 
-        auto minSize = QSize(m_maximumWidth, nextItem->sizeHint().height());
+#if defined(Q_OS_MACOS)
+    settingsPage->m_widget->resize(size());
+#else
+    // resizing needs to account for the category label & margins
 
-        auto propertyNames = {"size", "minimumSize", "maximumSize"};
+    auto margins = m_layout->contentsMargins();
 
-        for(auto property : propertyNames) {
-            auto sizeAnimation = new QPropertyAnimation(this, property);
+    auto adjustment = margins.bottom()+m_categoryLabel->height()+m_layout->spacing();
 
-            sizeAnimation->setDuration(TransisionDuration.count());
-            sizeAnimation->setStartValue(currentItem->size());
-            sizeAnimation->setEndValue(minSize);
+    settingsPage->m_widget->resize(m_stackedWidget->size()-QSize(margins.right(), adjustment));
+#endif
 
-            m_animationGroup->addAnimation(sizeAnimation);
-        }
+    settingsPage->m_needsResize = false;
+}
 
-        auto outgoingAnimation = new QPropertyAnimation(currentItem->transparencyEffect(), "opacity");
+auto Nedrysoft::SettingsDialog::SettingsDialog::showPage(SettingsPage *settingsPage) -> void {
+    if (m_tracer) {
+        beginPageSwitch(settingsPage);
+    }
 
-        outgoingAnimation->setDuration(TransisionDuration.count());
-        outgoingAnimation->setStartValue(currentItem->transparencyEffect()->opacity());
-        outgoingAnimation->setEndValue(AlphaTransparent);
+    createPageWidget(settingsPage);
 
-        m_animationGroup->addAnimation(outgoingAnimation);
+    if (settingsPage->m_needsResize) {
+        resizePage(settingsPage);
+    }
 
-        auto incomingAnimation = new QPropertyAnimation(nextItem->transparencyEffect(), "opacity");
+#if !defined(Q_OS_MACOS)
+    m_recentPages.removeOne(settingsPage);
+    m_recentPages.append(settingsPage);
 
-        incomingAnimation->setDuration(TransisionDuration.count());
-        incomingAnimation->setStartValue(nextItem->transparencyEffect()->opacity());
-        incomingAnimation->setEndValue(AlphaOpaque);
+    if (m_memoryBudget>0) {
+        evictPages(settingsPage);
+    }
+#endif
+}
 
-        m_animationGroup->addAnimation(incomingAnimation);
+auto Nedrysoft::SettingsDialog::SettingsDialog::evictPages(SettingsPage *visiblePage) -> void {
+#if defined(Q_OS_MACOS)
+    Q_UNUSED(visiblePage)
+#else
+    // a page remains in use until its apply has finished, so nothing is released while an apply is running
 
-        m_animationGroup->start(QParallelAnimationGroup::DeleteWhenStopped);
+    if (isApplying()) {
+        return;
+    }
 
-        // the current page is set here immediately, so that if the page is changed again before the animation is
-        // complete then the new selection will be animated in from the current position in the previous animation
+    // the least recently shown pages are at the front of the list
 
-        m_currentPage = settingsPage;
+    auto pageIterator = m_recentPages.begin();
 
-        connect(m_animationGroup, &QParallelAnimationGroup::finished, [this, settingsPage]() {
-            m_animationGroup->deleteLater();
+    while ((m_memoryUsage>m_memoryBudget) && (pageIterator!=m_recentPages.end())) {
+        auto settingsPage = *pageIterator;
 
-            m_animationGroup = nullptr;
+        if ((settingsPage!=visiblePage) && (settingsPage->m_isCreated) && (evictPage(settingsPage))) {
+            pageIterator = m_recentPages.erase(pageIterator);
+        } else {
+            ++pageIterator;
+        }
+    }
+#endif
+}
 
-            this->setWindowTitle(settingsPage->m_name);
-        });
-    });
+auto Nedrysoft::SettingsDialog::SettingsDialog::evictPage(SettingsPage *settingsPage) -> bool {
+#if defined(Q_OS_MACOS)
+    Q_UNUSED(settingsPage)
 
-    return settingsPage;
+    return false;
 #else
-    QTabWidget *tabWidget = nullptr;
-
-    for (int currentItem=0;currentItem<m_treeWidget->topLevelItemCount();currentItem++) {
-        QString itemSection = m_treeWidget->topLevelItem(currentItem)->text(0);
+    auto page = settingsPage->m_pageSettings;
+    auto state = page->saveState();
 
-        if (page->section()==itemSection) {
-            tabWidget = m_treeWidget->topLevelItem(currentItem)->data(0, Qt::UserRole).value<QTabWidget *>();
+    // releasing is opt in, a page that does not save its state may hold pointers to the widgets it created
 
-            break;
-        }
+    if (!state.isValid()) {
+        return false;
     }
 
-    if (!tabWidget) {
-        auto treeItem = new QTreeWidgetItem(m_treeWidget);
+    auto widgetLayout = settingsPage->m_container->layout();
 
-        tabWidget = new QTabWidget();
+    while (auto layoutItem = widgetLayout->takeAt(0)) {
+        delete layoutItem->widget();
+        delete layoutItem;
+    }
 
-        treeItem->setIcon(0, page->icon(themeSupport->isDarkMode()));
-        treeItem->setText(0, page->section());
-        treeItem->setData(0, Qt::UserRole, QVariant::fromValue(tabWidget));
-        treeItem->setData(0, Qt::ToolTipRole, page->description());
+    settingsPage->m_widget = nullptr;
+    settingsPage->m_isCreated = false;
+    settingsPage->m_savedState = state;
 
-        auto themeSupport = Nedrysoft::ThemeSupport::ThemeSupport::getInstance();
+    m_memoryUsage -= settingsPage->m_memoryCost;
 
-        tabWidget->setStyleSheet(updateStyleSheet(ThemeSubStylesheet, themeSupport->isDarkMode()));
+    return true;
+#endif
+}
 
-        auto signal = connect(
-            themeSupport,
-            &Nedrysoft::ThemeSupport::ThemeSupport::themeChanged,
-            [=](bool isDarkMode) {
+auto Nedrysoft::SettingsDialog::SettingsDialog::setMemoryBudget(qint64 kilobytes) -> void {
+#if defined(Q_OS_MACOS)
+    Q_UNUSED(kilobytes)
+#else
+    m_memoryBudget = kilobytes;
+#endif
+}
 
-                auto themeSupport = Nedrysoft::ThemeSupport::ThemeSupport::getInstance();
+auto Nedrysoft::SettingsDialog::SettingsDialog::setPrefetchBudget(int milliseconds) -> void {
+#if defined(Q_OS_MACOS)
+    Q_UNUSED(milliseconds)
+#else
+    m_prefetchBudget = qMax(1, milliseconds);
+#endif
+}
 
-                treeItem->setIcon(0, page->icon(themeSupport->isDarkMode()));
+auto Nedrysoft::SettingsDialog::SettingsDialog::nativeWindowHandle() -> QWindow * {
+    //
+    // @note the call to winId() is required as it sets up windowHandle() to return the correct value,
+    //       failing to call this will result in windowHandle not returning the correct value.
 
-                tabWidget->setStyleSheet(updateStyleSheet(ThemeSubStylesheet, themeSupport->isDarkMode()));
-            }
-        );
+    window()->winId();
 
-        connect(this, &QObject::destroyed, [themeSupport, signal]() {
-            themeSupport->disconnect(signal);
-        });
+    return window()->windowHandle();
+}
 
-        m_treeWidget->addTopLevelItem(treeItem);
+auto Nedrysoft::SettingsDialog::SettingsDialog::addPages(
+        const QList<ISettingsPage *> &pages) -> QList<Nedrysoft::SettingsDialog::SettingsPage *> {
 
-        connect(m_treeWidget, &QTreeWidget::currentItemChanged, [=](QTreeWidgetItem *current, QTreeWidgetItem *previous) {
-            Q_UNUSED(previous)
+    QList<SettingsPage *> settingsPages;
 
-            auto widget = current->data(0, Qt::UserRole).value<QWidget *>();
+    settingsPages.reserve(pages.count());
+    m_descriptors.reserve(m_descriptors.count()+pages.count());
+#if !defined(Q_OS_MACOS)
+    m_pages.reserve(m_pages.count()+pages.count());
+#endif
 
-            if (widget) {
-                m_stackedWidget->setCurrentWidget(widget);
-                m_categoryLabel->setText(current->text(0));
-            }
-        });
+    for (auto page: pages) {
+        settingsPages.append(registerPage(page));
+    }
+
+    return settingsPages;
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::registerPage(
+        ISettingsPage *page) -> Nedrysoft::SettingsDialog::SettingsPage * {
+
+    // the dirty state is tracked immediately, the remaining work is done once per batch of notifications
+
+    connect(page, &Nedrysoft::SettingsDialog::ISettingsPage::settingsChanged, this, [=]() {
+        m_dirtyPages.insert(page);
+        m_modifiedPages.insert(page);
+        m_modificationCounts[page]++;
+
+        if (!m_modifiedTimer->isActive()) {
+            m_modifiedTimer->start();
+        }
+    });
+
+    auto settingsPage = addPage(page);
+
+#if defined(Q_OS_MACOS)
+    m_pages[settingsPage->m_toolbarItem] = settingsPage;
+#else
+    m_pages.append(settingsPage);
+#endif
+
+    return settingsPage;
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::insertPage(ISettingsPage *page) -> bool {
+    if ((!page) || (m_descriptorIndex.contains(page))) {
+        return false;
+    }
+
+    registerPage(page);
+
+#if !defined(Q_OS_MACOS)
+    updateNavigationWidth();
+
+    if (!m_searchField->text().isEmpty()) {
+        filterSections(m_searchField->text());
+    }
+#endif
+
+    return true;
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::removePage(ISettingsPage *page) -> bool {
+    auto descriptorIndex = m_descriptorIndex.value(page, -1);
+
+    if ((descriptorIndex<0) || (isApplying())) {
+        return false;
+    }
+
+#if defined(Q_OS_MACOS)
+    auto settingsPage = m_sections.value(m_names.at(m_descriptors.at(descriptorIndex).m_sectionId));
+
+    if ((!settingsPage) || (settingsPage->m_pageSettings.count()<2)) {
+        return false;
+    }
+#else
+    // a page that is still waiting to be built only needs to be forgotten
+
+    if (m_pendingPages.removeOne(page)) {
+        m_descriptorIndex.remove(page);
+        m_descriptors[descriptorIndex].m_page = nullptr;
+
+        return true;
+    }
+
+    auto settingsPage = m_settingsPages.value(page);
+
+    if (!settingsPage) {
+        return false;
+    }
+#endif
+
+    disconnect(page, nullptr, this, nullptr);
+
+    m_dirtyPages.remove(page);
+    m_modifiedPages.remove(page);
+    m_modificationCounts.remove(page);
+    m_descriptorIndex.remove(page);
+    m_descriptors[descriptorIndex].m_page = nullptr;
+    m_iconCache->remove(page);
+    m_snapshot->remove(page);
+
+    if (m_tracer) {
+        m_tracer->removePage(page);
+    }
+
+#if defined(Q_OS_MACOS)
+    settingsPage->m_pageSettings.removeOne(page);
+
+    // the section widget cannot remove a single page, so it is replaced and the remaining pages are created again
+
+    auto previousWidget = settingsPage->m_widget;
+    auto wasCreated = settingsPage->m_isCreated;
+
+    settingsPage->m_widget = new TransparentWidget((settingsPage==m_currentPage) ? 1 : 0, this);
+    settingsPage->m_widget->setGeometry(previousWidget->geometry());
+    settingsPage->m_widget->setVisible(previousWidget->isVisible());
+    settingsPage->m_isCreated = false;
+
+    if (m_pageSwitchWidget==previousWidget) {
+        m_pageSwitchWidget = nullptr;
+    }
+
+    delete previousWidget;
+
+    if (wasCreated) {
+        createPageWidget(settingsPage);
+    }
+
+    auto themeSupport = Nedrysoft::ThemeSupport::ThemeSupport::getInstance();
+
+    settingsPage->m_icon = m_iconCache->icon(
+            settingsPage->m_pageSettings.first(),
+            SettingsIconSize,
+            themeSupport->isDarkMode(),
+            devicePixelRatioF());
+
+    settingsPage->m_toolbarItem->setIcon(settingsPage->m_icon);
+#else
+    auto section = m_sections.value(settingsPage->m_name);
+
+    m_prefetchQueue.removeOne(settingsPage);
+    m_pages.removeOne(settingsPage);
+    m_containerPages.remove(settingsPage->m_container);
+    m_settingsPages.remove(page);
+    m_searchIndex->removeDocument(descriptorIndex);
+
+    if (m_recentPages.removeOne(settingsPage)) {
+        m_memoryUsage -= settingsPage->m_memoryCost;
+    }
+
+    if (m_pageSwitchWidget==settingsPage->m_container) {
+        m_pageSwitchWidget = nullptr;
+    }
+
+    section->m_pages.removeOne(settingsPage);
+
+    if (section->m_tabWidget) {
+        section->m_tabWidget->removeTab(section->m_tabWidget->indexOf(settingsPage->m_container));
+    } else {
+        m_stackedWidget->removeWidget(settingsPage->m_container);
+    }
+
+    // the container owns the page widget, so the widget created by the page is released with it
+
+    delete settingsPage->m_container;
+    delete settingsPage;
+
+    if (section->m_pages.isEmpty()) {
+        removeSection(section);
+    } else {
+        // the icon and tooltip of the row are taken from the first page of the section
+
+        m_sectionModel->sectionChanged(section->m_index);
+    }
+
+    m_applyButton->setDisabled(!hasUnsavedChanges());
+#endif
+
+    return true;
+}
+
+#if !defined(Q_OS_MACOS)
+auto Nedrysoft::SettingsDialog::SettingsDialog::removeSection(SettingsSection *section) -> void {
+    m_sections.remove(section->m_name);
+
+    // removing the current row selects another section before the tab widget is removed from the stack
+
+    m_sectionModel->beginRemoveSection(section->m_index);
+
+    m_sectionList.removeAt(section->m_index);
+
+    for (auto sectionIndex=section->m_index;sectionIndex<m_sectionList.count();sectionIndex++) {
+        m_sectionList.at(sectionIndex)->m_index = sectionIndex;
+    }
+
+    m_sectionModel->endRemoveSection();
+
+    if (m_currentSection==section) {
+        m_currentSection = nullptr;
+    }
+
+    // a section without a tab widget displayed its page container directly, which has already been deleted
+
+    if (section->m_tabWidget) {
+        m_stackedWidget->removeWidget(section->m_tabWidget);
+
+        delete section->m_tabWidget;
+    }
+
+    delete section;
+
+    m_navigationWidth = 0;
+
+    for (auto remainingSection : m_sectionList) {
+        m_navigationWidth = qMax(m_navigationWidth, remainingSection->m_textWidth);
+    }
+
+    updateNavigationWidth();
+}
+#endif
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::processModifiedPages() -> void {
+    QList<ISettingsPage *> pages;
+
+    // pages that were applied or reloaded before the batch was processed are no longer modified
+
+    for (auto page : m_modifiedPages) {
+        if (m_dirtyPages.contains(page)) {
+            pages.append(page);
+        }
+    }
+
+    m_modifiedPages.clear();
+
+    if (pages.isEmpty()) {
+        return;
+    }
+
+    std::sort(pages.begin(), pages.end(), [=](ISettingsPage *first, ISettingsPage *second) {
+        return m_descriptorIndex.value(first)<m_descriptorIndex.value(second);
+    });
+
+#if !defined(Q_OS_MACOS)
+    m_applyButton->setDisabled(isApplying());
+#endif
+
+    Q_EMIT settingsModified(pages);
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::setChangeNotificationDelay(int milliseconds) -> void {
+    m_modifiedTimer->setInterval(qMax(0, milliseconds));
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::buildNextSlice() -> void {
+#if !defined(Q_OS_MACOS)
+    QElapsedTimer sliceTimer;
+
+    sliceTimer.start();
+
+    do {
+        registerPage(m_pendingPages.takeFirst());
+    } while ((!m_pendingPages.isEmpty()) && (sliceTimer.elapsed()<m_buildSliceBudget));
+
+    updateNavigationWidth();
+
+    if (!m_searchField->text().isEmpty()) {
+        filterSections(m_searchField->text());
+    }
+
+    if (!m_pendingPages.isEmpty()) {
+        QTimer::singleShot(0, this, [=]() {
+            buildNextSlice();
+        });
+
+        return;
+    }
+
+    Q_EMIT buildFinished();
+#endif
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::isBuilding() -> bool {
+#if defined(Q_OS_MACOS)
+    return false;
+#else
+    return !m_pendingPages.isEmpty();
+#endif
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::setBuildSliceBudget(int milliseconds) -> void {
+    m_buildSliceBudget = qMax(1, milliseconds);
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::updateNavigationWidth() -> void {
+#if !defined(Q_OS_MACOS)
+    m_navigationView->setMinimumWidth(m_navigationWidth+(SettingsIconSize*2));
+    m_navigationView->setMaximumWidth(m_navigationWidth+(SettingsIconSize*2));
+#endif
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::internName(const QString &name) -> int {
+    auto iterator = m_nameIds.constFind(name);
+
+    if (iterator!=m_nameIds.constEnd()) {
+        return iterator.value();
+    }
+
+    auto nameId = m_names.count();
+
+    m_names.append(name);
+    m_nameIds.insert(name, nameId);
+
+    return nameId;
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::describePage(
+        ISettingsPage *page) -> const Nedrysoft::SettingsDialog::PageDescriptor & {
+
+    auto descriptorIndex = m_descriptorIndex.value(page, -1);
+
+    if (descriptorIndex>=0) {
+        return m_descriptors.at(descriptorIndex);
+    }
+
+    // the page metadata is read once, all later lookups use the descriptor
+
+    PageDescriptor descriptor;
+
+    descriptor.m_page = page;
+    descriptor.m_sectionId = internName(page->section());
+    descriptor.m_categoryId = internName(page->category());
+    descriptor.m_description = page->description();
+
+    m_descriptorIndex.insert(page, m_descriptors.count());
+    m_descriptors.append(descriptor);
+
+    return m_descriptors.last();
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::addPage(ISettingsPage *page) -> Nedrysoft::SettingsDialog::SettingsPage * {
+    auto &descriptor = describePage(page);
+    auto sectionName = m_names.at(descriptor.m_sectionId);
+
+    if (m_tracer) {
+        m_tracer->setPageName(page, QString("%1 / %2").arg(sectionName).arg(m_names.at(descriptor.m_categoryId)));
+    }
+
+#if defined(Q_OS_MACOS)
+    auto themeSupport = Nedrysoft::ThemeSupport::ThemeSupport::getInstance();
+    auto settingsPage = m_sections.value(sectionName);
+
+    if (settingsPage) {
+        settingsPage->m_pageSettings.append(page);
+
+        if (settingsPage->m_isCreated) {
+            // the section has already been created, so the new page is appended to the existing widgets
+
+            settingsPage->m_isCreated = false;
+
+            createPageWidget(settingsPage);
+        }
+
+        return settingsPage;
+    }
+
+    settingsPage = new SettingsPage;
+
+    settingsPage->m_name = sectionName;
+    settingsPage->m_widget = new TransparentWidget(0, this);
+    settingsPage->m_pageSettings.append(page);
+    settingsPage->m_icon = m_iconCache->icon(page, SettingsIconSize, themeSupport->isDarkMode(), devicePixelRatioF());
+    settingsPage->m_description = descriptor.m_description;
+
+    m_sections[sectionName] = settingsPage;
+
+    if (!(m_options & LazyPages)) {
+        createPageWidget(settingsPage);
+    }
+
+    settingsPage->m_toolbarItem = m_toolbar->addItem(
+            settingsPage->m_icon,
+            sectionName);
+
+    connect(settingsPage->m_toolbarItem,
+            &Nedrysoft::MacHelper::MacToolbarItem::activated,
+            this,
+            [this, settingsPage]() {
+
+        showPage(settingsPage);
+
+        if (!m_currentPage) {
+            m_currentPage = settingsPage;
+            m_currentPage->m_widget->setOpacity(1);
+
+            resize(m_currentPage->m_widget->sizeHint());
+
+            this->setWindowTitle(settingsPage->m_name);
+
+            Q_EMIT pageChanged(settingsPage->m_name);
+
+            return;
+        }
+
+        auto currentItem = m_pages[m_currentPage->m_toolbarItem]->m_widget;
+        auto nextItem = settingsPage->m_widget;
+
+        if (currentItem==nextItem) {
+            return;
+        }
+
+        if (m_animationGroup) {
+            m_animationGroup->stop();
+            m_animationGroup->deleteLater();
+        }
+
+        m_animationGroup = new QParallelAnimationGroup;
+
+        auto minSize = QSize(m_maximumWidth, nextItem->sizeHint().height());
+
+        auto propertyNames = {"size", "minimumSize", "maximumSize"};
+
+        for(auto property : propertyNames) {
+            auto sizeAnimation = new QPropertyAnimation(this, property);
+
+            sizeAnimation->setDuration(TransisionDuration.count());
+            sizeAnimation->setStartValue(currentItem->size());
+            sizeAnimation->setEndValue(minSize);
+
+            m_animationGroup->addAnimation(sizeAnimation);
+        }
+
+        auto outgoingAnimation = new QPropertyAnimation(currentItem->transparencyEffect(), "opacity");
+
+        outgoingAnimation->setDuration(TransisionDuration.count());
+        outgoingAnimation->setStartValue(currentItem->transparencyEffect()->opacity());
+        outgoingAnimation->setEndValue(AlphaTransparent);
+
+        m_animationGroup->addAnimation(outgoingAnimation);
+
+        auto incomingAnimation = new QPropertyAnimation(nextItem->transparencyEffect(), "opacity");
+
+        incomingAnimation->setDuration(TransisionDuration.count());
+        incomingAnimation->setStartValue(nextItem->transparencyEffect()->opacity());
+        incomingAnimation->setEndValue(AlphaOpaque);
+
+        m_animationGroup->addAnimation(incomingAnimation);
+
+        m_animationGroup->start(QParallelAnimationGroup::DeleteWhenStopped);
+
+        // the current page is set here immediately, so that if the page is changed again before the animation is
+        // complete then the new selection will be animated in from the current position in the previous animation
+
+        m_currentPage = settingsPage;
+
+        Q_EMIT pageChanged(settingsPage->m_name);
+
+        connect(m_animationGroup, &QParallelAnimationGroup::finished, [this, settingsPage]() {
+            m_animationGroup->deleteLater();
+
+            m_animationGroup = nullptr;
+
+            this->setWindowTitle(settingsPage->m_name);
+        });
+    });
+
+    return settingsPage;
+#else
+    auto section = m_sections.value(sectionName);
+
+    auto isNewSection = !section;
+
+    if (isNewSection) {
+        section = new SettingsSection;
+
+        // the text width is measured once, the navigation width is recalculated from the cached widths
+
+        section->m_name = sectionName;
+        section->m_index = m_sectionList.count();
+        section->m_textWidth = m_navigationView->fontMetrics().horizontalAdvance(sectionName);
+
+        m_sections[sectionName] = section;
+
+        m_navigationWidth = qMax(m_navigationWidth, section->m_textWidth);
+    }
+
+    // the container is a lightweight placeholder until the page widget is created
+
+    auto widget = new QWidget;
+    auto widgetLayout = new QVBoxLayout;
+
+    widget->setLayout(widgetLayout);
+
+    auto settingsPage = new SettingsPage;
+
+    settingsPage->m_name = sectionName;
+    settingsPage->m_pageSettings = page;
+    settingsPage->m_container = widget;
+    settingsPage->m_description = descriptor.m_description;
+
+    m_containerPages[widget] = settingsPage;
+    m_settingsPages[page] = settingsPage;
+
+    indexPage(page);
+
+    section->m_pages.append(settingsPage);
+
+    if (section->m_tabWidget) {
+        section->m_tabWidget->addTab(widget, m_names.at(descriptor.m_categoryId));
+    } else if ((m_options & CompactSections) && (section->m_pages.count()==1)) {
+        // a section with a single category displays the page directly, the tab widget is created if a second
+        // category is added to the section
+
+        section->m_widget = widget;
+
+        // the name matches the stylesheet rule that gives the page the background of a tab pane
+
+        widget->setObjectName(CompactSectionName);
+
+        m_stackedWidget->addWidget(widget);
+    } else {
+        createSectionTabs(section);
+    }
+
+    if (isNewSection) {
+        // the row is added once the section has a page, so the view measures the row with its icon
+
+        m_sectionModel->beginAddSection();
+
+        m_sectionList.append(section);
+
+        m_sectionModel->endAddSection();
+    }
+
+    if (!(m_options & LazyPages)) {
+        createPageWidget(settingsPage);
+    }
+
+    return settingsPage;
+#endif
+}
+
+#if !defined(Q_OS_MACOS)
+auto Nedrysoft::SettingsDialog::SettingsDialog::selectSection(SettingsSection *section) -> void {
+    if (section==m_currentSection) {
+        return;
+    }
+
+    m_currentSection = section;
+
+    m_stackedWidget->setCurrentWidget(section->m_widget);
+    m_categoryLabel->setText(section->m_name);
+
+    auto settingsPage = sectionPage(section);
+
+    if (settingsPage) {
+        showPage(settingsPage);
+    }
+
+    if (m_options & Prefetch) {
+        prefetchNeighbours(section);
+    }
+
+    Q_EMIT pageChanged(section->m_name);
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::createSectionTabs(SettingsSection *section) -> void {
+    auto tabWidget = new QTabWidget;
+    auto isCurrent = (section==m_currentSection) ||
+                     ((section->m_widget) && (m_stackedWidget->currentWidget()==section->m_widget));
+
+    if (section->m_widget) {
+        m_stackedWidget->removeWidget(section->m_widget);
+
+        section->m_widget->setObjectName(QString());
+    }
+
+    for (auto settingsPage : section->m_pages) {
+        tabWidget->addTab(
+                settingsPage->m_container,
+                m_names.at(describePage(settingsPage->m_pageSettings).m_categoryId));
+    }
+
+    section->m_tabWidget = tabWidget;
+    section->m_widget = tabWidget;
+
+    m_sectionModel->sectionChanged(section->m_index);
+
+    m_stackedWidget->addWidget(tabWidget);
+
+    if (isCurrent) {
+        m_stackedWidget->setCurrentWidget(tabWidget);
+    }
+
+    connect(tabWidget, &QTabWidget::currentChanged, [=](int index) {
+        if (m_stackedWidget->currentWidget()!=tabWidget) {
+            return;
+        }
+
+        auto settingsPage = m_containerPages.value(tabWidget->widget(index));
+
+        if (settingsPage) {
+            showPage(settingsPage);
+        }
+    });
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::sectionPage(
+        SettingsSection *section) -> Nedrysoft::SettingsDialog::SettingsPage * {
+
+    if (section->m_tabWidget) {
+        return m_containerPages.value(section->m_tabWidget->currentWidget());
+    }
+
+    return section->m_pages.isEmpty() ? nullptr : section->m_pages.first();
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::setSectionPage(SettingsSection *section, SettingsPage *settingsPage) -> void {
+    if (section->m_tabWidget) {
+        section->m_tabWidget->setCurrentWidget(settingsPage->m_container);
+    }
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::indexPage(ISettingsPage *page) -> void {
+    auto descriptorIndex = m_descriptorIndex.value(page, -1);
+
+    if (descriptorIndex<0) {
+        return;
+    }
+
+    const auto &descriptor = m_descriptors.at(descriptorIndex);
+
+    // the keywords are only requested here, the index is searched without calling the page again
+
+    m_searchIndex->addDocument(descriptorIndex, QStringList{
+        m_names.at(descriptor.m_sectionId),
+        m_names.at(descriptor.m_categoryId),
+        descriptor.m_description,
+        page->keywords().join(" ")
+    }.join(" "));
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::filterSections(const QString &text) -> void {
+    auto start = m_tracer ? m_tracer->timestamp() : 0;
+
+    if (text.trimmed().isEmpty()) {
+        for (auto section : m_sectionList) {
+            m_navigationView->setRowHidden(section->m_index, false);
+        }
+
+        return;
+    }
+
+    auto matches = m_searchIndex->search(text);
+
+    for (auto section : m_sectionList) {
+        SettingsPage *firstMatch = nullptr;
+
+        for (auto settingsPage : section->m_pages) {
+            if (matches.contains(m_descriptorIndex.value(settingsPage->m_pageSettings, -1))) {
+                firstMatch = settingsPage;
+
+                break;
+            }
+        }
+
+        m_navigationView->setRowHidden(section->m_index, !firstMatch);
+
+        if ((!firstMatch) || (section==m_currentSection)) {
+            continue;
+        }
+
+        // the tab is changed while the section is hidden from view, so the page is not created until it is opened
+
+        auto currentPage = sectionPage(section);
+
+        if ((currentPage) && (!matches.contains(m_descriptorIndex.value(currentPage->m_pageSettings, -1)))) {
+            setSectionPage(section, firstMatch);
+        }
+    }
+
+    if (m_tracer) {
+        m_tracer->record("search", nullptr, start);
+    }
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::prefetchNeighbours(SettingsSection *section) -> void {
+    for (auto offset : {1, -1}) {
+        auto sectionIndex = section->m_index+offset;
+
+        if ((sectionIndex>=0) && (sectionIndex<m_sectionList.count())) {
+            prefetchSection(m_sectionList.at(sectionIndex), false);
+        }
+    }
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::prefetchSection(SettingsSection *section, bool isUrgent) -> void {
+    // the current tab of a section is the page that will be shown when the section is selected
+
+    auto settingsPage = sectionPage(section);
+
+    if ((!settingsPage) || (settingsPage->m_isCreated)) {
+        return;
+    }
+
+    m_prefetchQueue.removeOne(settingsPage);
+
+    if (isUrgent) {
+        m_prefetchQueue.prepend(settingsPage);
+    } else {
+        m_prefetchQueue.append(settingsPage);
+    }
+
+    schedulePrefetch(0);
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::schedulePrefetch(int delay) -> void {
+    if (m_isPrefetchScheduled) {
+        return;
+    }
+
+    m_isPrefetchScheduled = true;
+
+    QTimer::singleShot(delay, this, [=]() {
+        m_isPrefetchScheduled = false;
+
+        prefetchNextSlice();
+    });
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::prefetchNextSlice() -> void {
+    QElapsedTimer sliceTimer;
+
+    sliceTimer.start();
+
+    while ((!m_prefetchQueue.isEmpty()) && (sliceTimer.elapsed()<m_prefetchBudget)) {
+        createPageWidget(m_prefetchQueue.takeFirst());
+    }
+
+    if (m_memoryBudget) {
+        evictPages(visiblePage());
+    }
+
+    if (!m_prefetchQueue.isEmpty()) {
+        schedulePrefetch(0);
+    }
+}
+#endif
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::createPageWidget(SettingsPage *settingsPage) -> void {
+    if (settingsPage->m_isCreated) {
+        return;
+    }
+
+#if defined(Q_OS_MACOS)
+    auto widgetContainer = settingsPage->m_widget;
+
+    for (auto page : settingsPage->m_pageSettings.mid(widgetContainer->property("pageCount").toInt())) {
+        if (widgetContainer->count()) {
+            widgetContainer->addWidget(new SeparatorWidget);
+        }
+
+        auto start = m_tracer ? m_tracer->timestamp() : 0;
+        auto pageWidget = page->createWidget();
+
+        if (m_tracer) {
+            m_tracer->record("createWidget", page, start);
+        }
+
+        if (!m_snapshot->contains(page)) {
+            m_snapshot->capture(page);
+        }
+
+        if ((page==settingsPage->m_pageSettings.first()) && (pageWidget->layout())) {
+            pageWidget->layout()->setSizeConstraint(QLayout::SetMinimumSize);
+        }
+
+        widgetContainer->addWidget(pageWidget);
+    }
+
+    widgetContainer->setProperty("pageCount", settingsPage->m_pageSettings.count());
+
+    if (widgetContainer->sizeHint().width()>m_maximumWidth) {
+        m_maximumWidth = widgetContainer->sizeHint().width();
+    }
+#else
+    auto widgetLayout = qobject_cast<QVBoxLayout *>(settingsPage->m_container->layout());
+    auto page = settingsPage->m_pageSettings;
+    auto start = m_tracer ? m_tracer->timestamp() : 0;
+    auto pageWidget = page->createWidget();
+
+    if (m_tracer) {
+        m_tracer->record("createWidget", page, start);
+    }
+
+    // the snapshot is taken before any saved state is restored, so it holds the values that were last applied
+
+    if (!m_snapshot->contains(page)) {
+        m_snapshot->capture(page);
+    }
+
+    widgetLayout->addWidget(pageWidget);
+    widgetLayout->addSpacerItem(new QSpacerItem(0,0, QSizePolicy::Preferred, QSizePolicy::Expanding));
+
+    settingsPage->m_widget = pageWidget;
+
+    if (settingsPage->m_savedState.isValid()) {
+        // the page was released under the memory budget, restoring its state must not mark it as modified
+
+        auto isDirty = m_dirtyPages.contains(page);
+
+        page->restoreState(settingsPage->m_savedState);
+
+        settingsPage->m_savedState = QVariant();
+
+        if (!isDirty) {
+            m_dirtyPages.remove(page);
+        }
+    }
+
+    settingsPage->m_memoryCost = page->memoryUsage();
+
+    if (settingsPage->m_memoryCost<0) {
+        settingsPage->m_memoryCost = (pageWidget->findChildren<QWidget *>().count()+1)*EstimatedWidgetMemoryUsage;
+    }
+
+    m_memoryUsage += settingsPage->m_memoryCost;
+
+    m_recentPages.append(settingsPage);
+#endif
+    settingsPage->m_isCreated = true;
+}
+
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "ConstantConditionsOC"
+#pragma ide diagnostic ignored "UnreachableCode"
+auto Nedrysoft::SettingsDialog::SettingsDialog::closeEvent(QCloseEvent *event) -> void {
+    if (okToClose()) {
+        event->accept();
+
+        m_isClosed = true;
+
+        Q_EMIT closed();
+    } else {
+        event->ignore();
+    }
+}
+#pragma clang diagnostic pop
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::showEvent(QShowEvent *event) -> void {
+    // a dialog that is kept alive after closing refreshes its pages instead of being rebuilt
+
+    if (m_isClosed) {
+        m_isClosed = false;
+
+        reloadSettings();
+    }
+
+#if !defined(Q_OS_MACOS)
+    // once the dialog has been idle after opening, the sections either side of the current one are prepared
+
+    if ((m_options & Prefetch) && (m_currentSection)) {
+        for (auto offset : {1, -1}) {
+            auto sectionIndex = m_currentSection->m_index+offset;
+
+            if ((sectionIndex>=0) && (sectionIndex<m_sectionList.count())) {
+                auto settingsPage = sectionPage(m_sectionList.at(sectionIndex));
+
+                if ((settingsPage) && (!settingsPage->m_isCreated) && (!m_prefetchQueue.contains(settingsPage))) {
+                    m_prefetchQueue.append(settingsPage);
+                }
+            }
+        }
+
+        schedulePrefetch(PrefetchIdleDelay);
+    }
+#endif
+
+    QWidget::showEvent(event);
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::reloadSettings() -> void {
+    for(auto page : m_pages) {
+        // the edits held by a page that was released under the memory budget are discarded, the page reads the
+        // stored settings when it is created again
+
+        page->m_savedState = QVariant();
+
+#if defined(Q_OS_MACOS)
+        for (auto section : page->m_pageSettings) {
+            if ((!page->m_isCreated) || (section->reloadSettings())) {
+                m_dirtyPages.remove(section);
+
+                m_snapshot->capture(section);
+            }
+        }
+#else
+        if (!page->m_isCreated) {
+            m_dirtyPages.remove(page->m_pageSettings);
+
+            continue;
+        }
+
+        // a page that cannot refresh its widget still shows its edits, so it remains modified
+
+        if (page->m_pageSettings->reloadSettings()) {
+            m_dirtyPages.remove(page->m_pageSettings);
+
+            m_snapshot->capture(page->m_pageSettings);
+        }
+#endif
     }
 
-    auto widget = new QWidget;
-    auto widgetLayout = new QVBoxLayout;
-    auto pageWidget = page->createWidget();
+    if (m_settingsStore) {
+        m_settingsStore->discard();
+    }
 
-    widgetLayout->addWidget(pageWidget);
-    widgetLayout->addSpacerItem(new QSpacerItem(0,0, QSizePolicy::Preferred, QSizePolicy::Expanding));
+#if !defined(Q_OS_MACOS)
+    m_applyButton->setDisabled(!hasUnsavedChanges());
+#endif
+}
 
-    widget->setLayout(widgetLayout);
+auto Nedrysoft::SettingsDialog::SettingsDialog::currentSection() -> QString {
+#if defined(Q_OS_MACOS)
+    return m_currentPage ? m_currentPage->m_name : QString();
+#else
+    return m_currentSection ? m_currentSection->m_name : QString();
+#endif
+}
 
-    tabWidget->addTab(widget, page->category());
+auto Nedrysoft::SettingsDialog::SettingsDialog::setCurrentSection(const QString &section) -> bool {
+#if defined(Q_OS_MACOS)
+    Q_UNUSED(section)
 
-    m_stackedWidget->addWidget(tabWidget);
+    return false;
+#else
+    auto settingsSection = m_sections.value(section);
 
-    auto settingsPage = new SettingsPage;
+    if (!settingsSection) {
+        return false;
+    }
 
-    settingsPage->m_name = page->section();
-    settingsPage->m_widget = pageWidget;
-    settingsPage->m_pageSettings = page;
-    settingsPage->m_icon = page->icon();
-    settingsPage->m_description = page->description();
+    m_navigationView->setCurrentIndex(m_sectionModel->index(settingsSection->m_index));
 
-    return settingsPage;
+    return true;
 #endif
 }
 
-#pragma clang diagnostic push
-#pragma ide diagnostic ignored "ConstantConditionsOC"
-#pragma ide diagnostic ignored "UnreachableCode"
-auto Nedrysoft::SettingsDialog::SettingsDialog::closeEvent(QCloseEvent *event) -> void {
-    if (okToClose()) {
-        event->accept();
+auto Nedrysoft::SettingsDialog::SettingsDialog::acceptSettings() -> bool {
+    // only pages that have signalled a change since they were last accepted are validated and accepted
 
-        Q_EMIT closed();
-    } else {
-        event->ignore();
+    auto pages = dirtyPages();
+
+    if (!validatePages(pages)) {
+        return false;
+    }
+
+    for (auto page : pages) {
+        auto start = m_tracer ? m_tracer->timestamp() : 0;
+
+        commitPage(page);
+
+        if (m_tracer) {
+            m_tracer->record("acceptSettings", page, start);
+        }
+
+        m_dirtyPages.remove(page);
     }
+
+    auto isSaved = flushSettingsStore();
+
+#if !defined(Q_OS_MACOS)
+    // changes that could not be saved are kept by the store, so apply remains available to try again
+
+    this->m_applyButton->setDisabled(!hasUnsavedChanges());
+#endif
+
+    return isSaved;
 }
-#pragma clang diagnostic pop
 
-auto Nedrysoft::SettingsDialog::SettingsDialog::acceptSettings() -> bool {
-    bool settingsValid = true;
+auto Nedrysoft::SettingsDialog::SettingsDialog::setSettingsStore(SettingsStore *store) -> void {
+    m_settingsStore = store;
+}
 
-#if defined(Q_OS_MACOS)
-    for(auto page : m_pages) {
-        for (auto section : page->m_pageSettings) {
-            if (!section->canAcceptSettings()) {
-                settingsValid = false;
-                break;
+auto Nedrysoft::SettingsDialog::SettingsDialog::flushSettingsStore() -> bool {
+    if ((!m_settingsStore) || (m_settingsStore->flush())) {
+        return true;
+    }
+
+    QMessageBox::warning(this, windowTitle(), tr("The settings could not be saved to %1.").arg(m_settingsStore->filename()));
+
+    return false;
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::hasUnsavedChanges() -> bool {
+    return ((!m_dirtyPages.isEmpty()) || ((m_settingsStore) && (m_settingsStore->hasPendingChanges())));
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::commitPage(ISettingsPage *page) -> void {
+    if (!m_snapshot->contains(page)) {
+        page->acceptSettings();
+
+        return;
+    }
+
+    auto values = page->snapshotSettings();
+    auto changes = m_snapshot->changes(page);
+
+    if (changes.isEmpty()) {
+        return;
+    }
+
+    page->commitSettings(changes);
+
+    m_snapshot->commit(page, values);
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::revertSettings() -> void {
+    for (auto page : dirtyPages()) {
+#if !defined(Q_OS_MACOS)
+        // the edits held by a page that was released under the memory budget are discarded, the page has no
+        // widget to roll back and reads the stored settings when it is created again
+
+        auto settingsPage = m_settingsPages.value(page);
+
+        if (settingsPage) {
+            settingsPage->m_savedState = QVariant();
+
+            if (!settingsPage->m_isCreated) {
+                m_dirtyPages.remove(page);
+
+                continue;
             }
         }
+#endif
+        if (!m_snapshot->contains(page)) {
+            continue;
+        }
+
+        page->rollbackSettings(m_snapshot->values(page));
+
+        m_dirtyPages.remove(page);
     }
 
-    if (!settingsValid) {
-        //TODO go to page with error
-    } else {
-        for(auto page : m_pages) {
-            for (auto section : page->m_pageSettings) {
-                section->acceptSettings();
+    // changes from an earlier apply that could not be saved must not be written by a later, unrelated apply
+
+    if (m_settingsStore) {
+        m_settingsStore->discard();
+    }
+
+#if !defined(Q_OS_MACOS)
+    m_applyButton->setDisabled(!hasUnsavedChanges());
+#endif
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::validateSettings(
+        const QList<ISettingsPage *> &pages) -> QVector<Nedrysoft::SettingsDialog::ValidationResult> {
+
+    QVector<ValidationResult> results(pages.count());
+
+    // the results are written by index, so the buffer must not be reallocated while validators are running
+
+    auto resultData = results.data();
+    auto tracer = m_tracer;
+
+    // each page is asked once, so a page is validated exactly once even if its answer were to change
+
+    QVector<bool> isThreadSafe(pages.count());
+
+    for (auto pageIndex=0;pageIndex<pages.count();pageIndex++) {
+        isThreadSafe[pageIndex] = pages.at(pageIndex)->isThreadSafe();
+    }
+
+    for (auto pageIndex=0;pageIndex<pages.count();pageIndex++) {
+        auto page = pages.at(pageIndex);
+
+        if (isThreadSafe.at(pageIndex)) {
+            m_validationPool->start([page, resultData, pageIndex, tracer]() {
+                auto start = tracer ? tracer->timestamp() : 0;
+
+                resultData[pageIndex] = page->validateSettings();
+                resultData[pageIndex].m_page = page;
+
+                if (tracer) {
+                    tracer->record("validateSettings", page, start);
+                }
+            });
+        }
+    }
+
+    for (auto pageIndex=0;pageIndex<pages.count();pageIndex++) {
+        auto page = pages.at(pageIndex);
+
+        if (!isThreadSafe.at(pageIndex)) {
+            auto start = tracer ? tracer->timestamp() : 0;
+
+            resultData[pageIndex] = page->validateSettings();
+            resultData[pageIndex].m_page = page;
+
+            if (tracer) {
+                tracer->record("validateSettings", page, start);
             }
         }
+    }
+
+    m_validationPool->waitForDone();
+
+    return results;
+}
 
+auto Nedrysoft::SettingsDialog::SettingsDialog::validatePages(const QList<ISettingsPage *> &pages) -> bool {
+    if (pages.isEmpty()) {
         return true;
     }
+
+#if !defined(Q_OS_MACOS)
+    // modified pages that were released under the memory budget are recreated before being validated
+
+    for (auto page : pages) {
+        auto settingsPage = m_settingsPages.value(page);
+
+        if ((settingsPage) && (!settingsPage->m_isCreated)) {
+            createPageWidget(settingsPage);
+        }
+    }
+#endif
+
+    for (auto result : validateSettings(pages)) {
+        if (!result.m_isValid) {
+            selectPage(result.m_page);
+
+            if (!result.m_message.isEmpty()) {
+                QMessageBox::warning(this, windowTitle(), result.m_message);
+            }
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::selectPage(ISettingsPage *page) -> void {
+#if defined(Q_OS_MACOS)
+    Q_UNUSED(page)
 #else
-    for(auto page : m_pages) {
+    auto descriptorIndex = m_descriptorIndex.value(page, -1);
+
+    if (descriptorIndex<0) {
+        return;
+    }
+
+    auto section = m_sections.value(m_names.at(m_descriptors.at(descriptorIndex).m_sectionId));
+
+    if (!section) {
+        return;
+    }
+
+    for (auto settingsPage : section->m_pages) {
+        if (settingsPage->m_pageSettings==page) {
+            m_navigationView->setCurrentIndex(m_sectionModel->index(section->m_index));
+
+            setSectionPage(section, settingsPage);
 
-        if (!page->m_pageSettings->canAcceptSettings()) {
-            settingsValid = false;
             break;
         }
     }
+#endif
+}
 
-    if (!settingsValid) {
-        //TODO go to page with error
-    } else {
-        for(auto page : m_pages) {
-            page->m_pageSettings->acceptSettings();
+auto Nedrysoft::SettingsDialog::SettingsDialog::startApply(bool closeWhenFinished) -> bool {
+#if defined(Q_OS_MACOS)
+    Q_UNUSED(closeWhenFinished)
+
+    return acceptSettings();
+#else
+    if (isApplying()) {
+        return false;
+    }
+
+    auto pages = dirtyPages();
+
+    if (!validatePages(pages)) {
+        return false;
+    }
+
+    // transactional pages that were edited back to their recorded values do not need to be applied
+
+    for (auto page : dirtyPages()) {
+        if ((m_snapshot->contains(page)) && (m_snapshot->changes(page).isEmpty())) {
+            pages.removeOne(page);
+
+            m_dirtyPages.remove(page);
         }
+    }
 
-        this->m_applyButton->setDisabled(true);
+    if (pages.isEmpty()) {
+        // changes that could not be saved by an earlier apply are written again
 
-        return true;
+        auto isSaved = flushSettingsStore();
+
+        m_applyButton->setDisabled(!hasUnsavedChanges());
+
+        if ((isSaved) && (closeWhenFinished)) {
+            close();
+        }
+
+        return isSaved;
+    }
+
+    m_applyCancelled = false;
+    m_closeAfterApply = closeWhenFinished;
+
+    m_okButton->setDisabled(true);
+    m_applyButton->setDisabled(true);
+
+    m_applyProgress->setRange(0, pages.count());
+    m_applyProgress->setValue(0);
+    m_applyProgress->setVisible(true);
+
+    // independent pages are all started immediately, the remaining pages are applied one after another
+
+    for (auto page : pages) {
+        if (page->isIndependent()) {
+            applyPage(page);
+        } else {
+            m_applyQueue.append(page);
+        }
+    }
+
+    if (!m_applyQueue.isEmpty()) {
+        applyPage(m_applyQueue.takeFirst());
+    }
+
+    return true;
+#endif
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::applyPage(ISettingsPage *page) -> void {
+    auto start = m_tracer ? m_tracer->timestamp() : 0;
+
+#if defined(Q_OS_MACOS)
+    commitPage(page);
+
+    if (m_tracer) {
+        m_tracer->record("acceptSettings", page, start);
+    }
+#else
+    // transactional pages are given only the values that differ, the values are recorded as committed once the
+    // apply has finished
+
+    auto isTransactional = m_snapshot->contains(page);
+    auto values = isTransactional ? page->snapshotSettings() : QVariantMap();
+
+    // a page that is edited while it is being applied remains modified
+
+    auto modificationCount = m_modificationCounts.value(page);
+
+    auto watcher = new QFutureWatcher<void>(this);
+
+    m_applyWatchers.append(watcher);
+
+    connect(watcher, &QFutureWatcher<void>::finished, [=]() {
+        m_applyWatchers.removeOne(watcher);
+
+        watcher->deleteLater();
+
+        // an asynchronous apply is timed from when it was started until the dialog is told that it has finished
+
+        if (m_tracer) {
+            m_tracer->record("acceptSettings", page, start);
+        }
+
+        if (!watcher->future().isCanceled()) {
+            if (m_modificationCounts.value(page)==modificationCount) {
+                m_dirtyPages.remove(page);
+            }
+
+            if (isTransactional) {
+                m_snapshot->commit(page, values);
+            }
+        }
+
+        m_applyProgress->setValue(m_applyProgress->value()+1);
+
+        if ((!page->isIndependent()) && (!m_applyCancelled) && (!m_applyQueue.isEmpty())) {
+            applyPage(m_applyQueue.takeFirst());
+        }
+
+        if (m_applyWatchers.isEmpty()) {
+            finishApply();
+        }
+    });
+
+    // the watcher always signals finished from the event loop, even if the returned future has already completed
+
+    if (isTransactional) {
+        watcher->setFuture(page->commitSettingsAsync(m_snapshot->changes(page)));
+    } else {
+        watcher->setFuture(page->acceptSettingsAsync());
+    }
+#endif
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::finishApply() -> void {
+#if !defined(Q_OS_MACOS)
+    m_applyQueue.clear();
+
+    // the pages that completed are saved even if the apply was cancelled, so the file matches the pages
+
+    auto success = ((flushSettingsStore()) && (!m_applyCancelled));
+
+    m_applyProgress->setVisible(false);
+
+    m_okButton->setDisabled(false);
+    m_applyButton->setDisabled(!hasUnsavedChanges());
+
+    if (m_memoryBudget>0) {
+        evictPages(visiblePage());
+    }
+
+    Q_EMIT applyFinished(success);
+
+    if ((success) && (m_closeAfterApply)) {
+        close();
     }
 #endif
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::isApplying() -> bool {
+#if defined(Q_OS_MACOS)
     return false;
+#else
+    return !m_applyWatchers.isEmpty();
+#endif
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::cancelApply() -> void {
+#if !defined(Q_OS_MACOS)
+    if (!isApplying()) {
+        return;
+    }
+
+    m_applyCancelled = true;
+
+    m_applyQueue.clear();
+
+    for (auto watcher : m_applyWatchers) {
+        watcher->future().cancel();
+    }
+#endif
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::dirtyPages() -> QList<Nedrysoft::SettingsDialog::ISettingsPage *> {
+    QList<ISettingsPage *> pages;
+
+    for(auto page : m_pages) {
+#if defined(Q_OS_MACOS)
+        for (auto section : page->m_pageSettings) {
+            if (m_dirtyPages.contains(section)) {
+                pages.append(section);
+            }
+        }
+#else
+        if (m_dirtyPages.contains(page->m_pageSettings)) {
+            pages.append(page->m_pageSettings);
+        }
+#endif
+    }
+
+    return pages;
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::isDirty(ISettingsPage *page) -> bool {
+    return m_dirtyPages.contains(page);
+}
+
+auto Nedrysoft::SettingsDialog::SettingsDialog::themeStyleSheet(bool isDarkMode) -> QString {
+    // both variants are generated once per process, QString is implicitly shared so returning a copy is cheap
+
+    static const QString lightStyleSheet = updateStyleSheet(ThemeStylesheet, false);
+    static const QString darkStyleSheet = updateStyleSheet(ThemeStylesheet, true);
+
+    return isDarkMode ? darkStyleSheet : lightStyleSheet;
 }
 
 auto Nedrysoft::SettingsDialog::SettingsDialog::updateStyleSheet(
@@ -28,18 +28,29 @@
 
 #include "SettingsDialogSpec.h"
 
+#include <QFutureWatcher>
+#include <QHash>
 #include <QIcon>
 #include <QList>
 #include <QMap>
+#include <QSet>
 #include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
 #include <QWidget>
 
 class QHBoxLayout;
 class QLabel;
+class QLineEdit;
 class QParallelAnimationGroup;
+class QProgressBar;
+class QThreadPool;
+class QTimer;
 class QPushButton;
 class QStackedWidget;
-class QTreeWidget;
+class QTabWidget;
+class QListView;
 class QVBoxLayout;
 
 namespace Nedrysoft { namespace ThemeSupport {
@@ -54,6 +65,13 @@ namespace Nedrysoft { namespace MacHelper {
 namespace Nedrysoft { namespace SettingsDialog {
     class TransparentWidget;
     class ISettingsPage;
+    class SettingsIconCache;
+    class SettingsSearchIndex;
+    class SettingsSectionModel;
+    class SettingsSnapshot;
+    class SettingsStore;
+    class SettingsTracer;
+    class ValidationResult;
 
     /**
      * @brief       The SettingsPage class describes an individual page of the application settings
@@ -66,8 +84,12 @@ namespace Nedrysoft { namespace SettingsDialog {
                 m_pageSettings(QList<ISettingsPage *>()),
 #else
                 m_pageSettings(nullptr),
+                m_container(nullptr),
 #endif
-                m_widget(nullptr) {
+                m_widget(nullptr),
+                m_isCreated(false),
+                m_needsResize(false),
+                m_memoryCost(0) {
 
                 }
 
@@ -83,11 +105,98 @@ namespace Nedrysoft { namespace SettingsDialog {
 #else
             QWidget *m_widget;
             ISettingsPage *m_pageSettings;
+            QWidget *m_container;
 #endif
             QIcon m_icon;
+            bool m_isCreated;
+            bool m_needsResize;
+            qint64 m_memoryCost;
+            QVariant m_savedState;
+
+            //! @endcond
+    };
+
+    /**
+     * @brief       The PageDescriptor class holds the metadata of a settings page.
+     *
+     * @details     The metadata is captured once when the page is added, section and category names are interned
+     *              and referenced by id.  The page pointer is also the key used for the icon cache.
+     */
+    class PageDescriptor {
+        public:
+            PageDescriptor() :
+                m_page(nullptr),
+                m_sectionId(-1),
+                m_categoryId(-1) {
+
+                }
+
+        public:
+            //! @cond
+
+            ISettingsPage *m_page;
+            int m_sectionId;
+            int m_categoryId;
+            QString m_description;
+
+            //! @endcond
+    };
+
+    /**
+     * @brief       The TraceEvent class holds the timing of a single call made by the dialog.
+     *
+     * @details     Events are named after the call that was timed (i.e createWidget, validateSettings,
+     *              acceptSettings, icon, themeChanged, pageSwitch or search), times are in nanoseconds measured from
+     *              when the dialog was constructed.
+     */
+    class TraceEvent {
+        public:
+            TraceEvent() :
+                m_start(0),
+                m_duration(0),
+                m_threadId(0) {
+
+                }
+
+        public:
+            //! @cond
+
+            QString m_name;
+            QString m_page;
+            qint64 m_start;
+            qint64 m_duration;
+            quintptr m_threadId;
+
+            //! @endcond
+    };
+
+#if !defined(Q_OS_MACOS)
+    /**
+     * @brief       The SettingsSection class describes a section (first level grouping) of the application settings.
+     */
+    class SettingsSection {
+        public:
+            SettingsSection() :
+                m_index(-1),
+                m_textWidth(0),
+                m_tabWidget(nullptr),
+                m_widget(nullptr) {
+
+                }
+
+        public:
+            //! @cond
+
+            QString m_name;
+            int m_index;
+            int m_textWidth;
+            QTabWidget *m_tabWidget;
+            QWidget *m_widget;
+            QList<SettingsPage *> m_pages;
 
             //! @endcond
     };
+#endif
 
     /**
     * @brief        The SettingsDialog class provides a common themed settings dialog for Windows and Linux
@@ -104,6 +213,22 @@ namespace Nedrysoft { namespace SettingsDialog {
             //Q_DISABLE_COPY(SettingsDialog)
             //Q_DISABLE_MOVE(SettingsDialog)
 
+        public:
+            /**
+             * @brief       Options that control how the dialog is constructed.
+             */
+            enum Option {
+                NoOptions = 0x00,                   /**< All page widgets are created when the dialog is constructed. */
+                LazyPages = 0x01,                   /**< Page widgets are created the first time they are shown. */
+                AsyncApply = 0x02,                  /**< Settings are applied asynchronously and can be cancelled. */
+                IncrementalBuild = 0x04,            /**< Sections after the first are built from the event loop. */
+                Prefetch = 0x08,                    /**< Pages that are likely to be shown next are created early. */
+                Tracing = 0x10,                     /**< Calls made to the pages are timed and recorded. */
+                CompactSections = 0x20              /**< Sections with a single category are shown without tabs. */
+            };
+
+            Q_DECLARE_FLAGS(Options, Option)
+
         public:
             /**
              * @brief       Constructs a new SettingsDialog instance which is a child of the parent.
@@ -113,16 +238,254 @@ namespace Nedrysoft { namespace SettingsDialog {
              */
             explicit SettingsDialog(const QList<ISettingsPage *> &pages, QWidget *parent=nullptr);
 
+            /**
+             * @brief       Constructs a new SettingsDialog instance which is a child of the parent.
+             *
+             * @note        When LazyPages is set, the navigation entries are created from the page metadata and
+             *              ISettingsPage::createWidget() is not called until the page is first displayed.
+             *
+             * @param[in]   pages the pages to be displayed.
+             * @param[in]   options the options used to construct the dialog.
+             * @param[in]   parent is the the owner of the child.
+             */
+            SettingsDialog(const QList<ISettingsPage *> &pages, Options options, QWidget *parent=nullptr);
+
             /**
              * @brief       Destroys the SettingsDialog.
              */
             ~SettingsDialog();
 
+            /**
+             * @brief       Adds a page to a dialog that has already been constructed.
+             *
+             * @details     The page is added to its section, creating the section if required, without rebuilding
+             *              the rest of the dialog.  This allows pages provided by a plugin to be added when the
+             *              plugin is loaded.
+             *
+             * @param[in]   page the page to add.
+             *
+             * @returns     true if the page was added; false if the page is already in the dialog.
+             */
+            auto insertPage(ISettingsPage *page) -> bool;
+
+            /**
+             * @brief       Removes a page from the dialog.
+             *
+             * @details     The widget created by the page is destroyed immediately and the dialog disconnects from
+             *              the page, a section is removed along with its last page.  The caller retains ownership of
+             *              the page.
+             *
+             * @note        On macOS the toolbar cannot remove an item, so the last page of a section cannot be removed.
+             *
+             * @param[in]   page the page to remove.
+             *
+             * @returns     true if the page was removed; otherwise false.
+             */
+            auto removePage(ISettingsPage *page) -> bool;
+
+            /**
+             * @brief       Validates a list of pages.
+             *
+             * @details     Pages that report themselves as thread safe are validated concurrently on a thread pool
+             *              while the remaining pages are validated on the calling thread.
+             *
+             * @param[in]   pages the pages to validate.
+             *
+             * @returns     the validation result for each page, in the same order as the pages.
+             */
+            auto validateSettings(const QList<ISettingsPage *> &pages) -> QVector<ValidationResult>;
+
+            /**
+             * @brief       Returns the pages that have changed since their settings were last accepted.
+             *
+             * @returns     the list of modified pages in the order they appear in the dialog.
+             */
+            auto dirtyPages() -> QList<ISettingsPage *>;
+
+            /**
+             * @brief       Checks if a page has changed since its settings were last accepted.
+             *
+             * @param[in]   page the page to check.
+             *
+             * @returns     true if the page has been modified; otherwise false.
+             */
+            auto isDirty(ISettingsPage *page) -> bool;
+
+            /**
+             * @brief       Returns whether an asynchronous apply is in progress.
+             *
+             * @returns     true if settings are being applied; otherwise false.
+             */
+            auto isApplying() -> bool;
+
+            /**
+             * @brief       Cancels an asynchronous apply that is in progress.
+             *
+             * @note        Pages that have not completed remain modified and will be applied on the next apply.
+             */
+            auto cancelApply() -> void;
+
+            /**
+             * @brief       Returns whether the dialog is still being built incrementally.
+             *
+             * @returns     true if pages are waiting to be added; otherwise false.
+             */
+            auto isBuilding() -> bool;
+
+            /**
+             * @brief       Sets the time allowed for each slice of an incremental build.
+             *
+             * @note        Each slice adds at least one page, so a slow page may exceed the budget.
+             *
+             * @param[in]   milliseconds the budget in milliseconds.
+             */
+            auto setBuildSliceBudget(int milliseconds) -> void;
+
+            /**
+             * @brief       Refreshes the state of all created pages from their settings.
+             *
+             * @details     Called automatically when a dialog that has been closed is shown again, this allows a
+             *              host to keep the dialog alive between uses instead of rebuilding it.  Unapplied
+             *              changes are discarded, except on pages that cannot refresh their widget (see
+             *              ISettingsPage::reloadSettings()), which remain modified.
+             */
+            auto reloadSettings() -> void;
+
+            /**
+             * @brief       Sets the store that the pages write their settings to.
+             *
+             * @details     The store is flushed once after all modified pages have been accepted, so an apply
+             *              results in a single write of the settings file.
+             *
+             * @param[in]   store the store; or nullptr if the pages save their own settings.
+             */
+            auto setSettingsStore(SettingsStore *store) -> void;
+
+            /**
+             * @brief       Discards the unapplied changes of the transactional pages.
+             *
+             * @details     Transactional pages (see ISettingsPage::snapshotSettings()) are restored from the values
+             *              recorded when they were created or last applied, no settings are read from storage.  This
+             *              is called when the dialog is cancelled.
+             */
+            auto revertSettings() -> void;
+
+            /**
+             * @brief       Returns the name of the section that is currently displayed.
+             *
+             * @returns     the section name; or an empty string if no section is displayed.
+             */
+            auto currentSection() -> QString;
+
+            /**
+             * @brief       Displays a section.
+             *
+             * @param[in]   section the name of the section.
+             *
+             * @returns     true if the section was found; otherwise false.
+             */
+            auto setCurrentSection(const QString &section) -> bool;
+
+            /**
+             * @brief       Sets the memory budget for page widgets.
+             *
+             * @details     When the estimated memory used by page widgets exceeds the budget, the widgets of the
+             *              pages that have been hidden the longest are destroyed (after saving their state through
+             *              ISettingsPage::saveState()) and are created again when next shown.  Only pages that
+             *              return a valid state from saveState() are released.
+             *
+             * @param[in]   kilobytes the budget in kilobytes, 0 disables the budget.
+             */
+            auto setMemoryBudget(qint64 kilobytes) -> void;
+
+            /**
+             * @brief       Sets the time that may be spent creating prefetched pages in each turn of the event loop.
+             *
+             * @note        Prefetching is enabled with the Prefetch option and is most useful with LazyPages.
+             *
+             * @param[in]   milliseconds the budget in milliseconds.
+             */
+            auto setPrefetchBudget(int milliseconds) -> void;
+
+            /**
+             * @brief       Sets how long change notifications from pages are collected before being processed.
+             *
+             * @details     Pages may emit ISettingsPage::settingsChanged() on every keystroke, the dialog collects
+             *              the pages that changed and handles them once per batch, emitting settingsModified().
+             *
+             * @param[in]   milliseconds the window in milliseconds, 0 (the default) batches the changes made in
+             *              a single turn of the event loop.
+             */
+            auto setChangeNotificationDelay(int milliseconds) -> void;
+
+            /**
+             * @brief       Filters the navigation tree to the sections that match a search.
+             *
+             * @details     Sections are matched from an index of the section and category names, descriptions and
+             *              keywords of the pages, so no page widgets are created by searching.  A matching section
+             *              that is not displayed switches to the first page that matched, which is only created if
+             *              the user opens the section.
+             *
+             * @note        The search field is only available on Windows and Linux.
+             *
+             * @param[in]   text the search text, an empty string shows all sections.
+             */
+            auto setSearchText(const QString &text) -> void;
+
+            /**
+             * @brief       Returns the timings recorded by the dialog.
+             *
+             * @note        Events are only recorded when the dialog is constructed with the Tracing option.
+             *
+             * @returns     the recorded events in the order they finished.
+             */
+            auto traceEvents() -> QVector<TraceEvent>;
+
+            /**
+             * @brief       Removes all recorded timings.
+             */
+            auto clearTraceEvents() -> void;
+
+            /**
+             * @brief       Writes the recorded timings to a file in the Chrome trace event format.
+             *
+             * @param[in]   filename the name of the file to write.
+             *
+             * @returns     true if the file was written; otherwise false.
+             */
+            auto exportTrace(const QString &filename) -> bool;
+
             /**
              * @brief       This signal is emitted when the window is closed by the user.
              */
             Q_SIGNAL void closed();
 
+            /**
+             * @brief       This signal is emitted when an asynchronous apply has finished.
+             *
+             * @param[in]   success true if all pages were applied; false if the apply was cancelled.
+             */
+            Q_SIGNAL void applyFinished(bool success);
+
+            /**
+             * @brief       This signal is emitted once for each batch of change notifications from the pages.
+             *
+             * @param[in]   pages the pages that changed in the batch and are still modified, in dialog order.
+             */
+            Q_SIGNAL void settingsModified(const QList<Nedrysoft::SettingsDialog::ISettingsPage *> &pages);
+
+            /**
+             * @brief       This signal is emitted when an incremental build has added all pages.
+             */
+            Q_SIGNAL void buildFinished();
+
+            /**
+             * @brief       This signal is emitted when the user navigates to a different section.
+             *
+             * @param[in]   section the name of the section that is now displayed.
+             */
+            Q_SIGNAL void pageChanged(const QString &section);
+
         protected:
             /**
              * @brief       Reimplements: QWidget::closeEvent(QCloseEvent *event).
@@ -131,6 +494,23 @@ namespace Nedrysoft { namespace SettingsDialog {
              */
             auto closeEvent(QCloseEvent *event) -> void override;
 
+            /**
+             * @brief       Reimplements: QWidget::showEvent(QShowEvent *event).
+             *
+             * @param[in]   event the event information.
+             */
+            auto showEvent(QShowEvent *event) -> void override;
+
+            /**
+             * @brief       Reimplements: QObject::eventFilter(QObject *watched, QEvent *event).
+             *
+             * @param[in]   watched the object that the event was sent to.
+             * @param[in]   event the event information.
+             *
+             * @returns     true if the event was handled; otherwise false.
+             */
+            auto eventFilter(QObject *watched, QEvent *event) -> bool override;
+
             /**
              * @brief       Returns the recommended size for the widget.
              *
@@ -160,6 +540,67 @@ namespace Nedrysoft { namespace SettingsDialog {
              */
             auto acceptSettings() -> bool;
 
+            /**
+             * @brief       Applies the settings of a page.
+             *
+             * @details     A transactional page is passed the values that differ from its snapshot, an unmodified
+             *              transactional page is not applied.  Other pages have all their settings applied.
+             *
+             * @param[in]   page the page to apply.
+             */
+            auto commitPage(ISettingsPage *page) -> void;
+
+            /**
+             * @brief       Writes the settings store to disk, reporting a failure to the user.
+             *
+             * @returns     true if the settings were saved; otherwise false.
+             */
+            auto flushSettingsStore() -> bool;
+
+            /**
+             * @brief       Checks if there are modified pages or settings that have not been saved.
+             *
+             * @returns     true if there are changes to apply; otherwise false.
+             */
+            auto hasUnsavedChanges() -> bool;
+
+            /**
+             * @brief       Validates a list of pages and displays the first page that is invalid.
+             *
+             * @param[in]   pages the pages to validate.
+             *
+             * @returns     true if all pages are valid; otherwise false.
+             */
+            auto validatePages(const QList<ISettingsPage *> &pages) -> bool;
+
+            /**
+             * @brief       Navigates to the section and category that contains a page.
+             *
+             * @param[in]   page the page to display.
+             */
+            auto selectPage(ISettingsPage *page) -> void;
+
+            /**
+             * @brief       Validates the modified settings and starts applying them asynchronously.
+             *
+             * @param[in]   closeWhenFinished true if the dialog should be closed once all pages have been applied.
+             *
+             * @returns     true if the apply was started; otherwise false.
+             */
+            auto startApply(bool closeWhenFinished) -> bool;
+
+            /**
+             * @brief       Starts applying a single page as part of an asynchronous apply.
+             *
+             * @param[in]   page the page to apply.
+             */
+            auto applyPage(ISettingsPage *page) -> void;
+
+            /**
+             * @brief       Completes an asynchronous apply, restoring the state of the dialog.
+             */
+            auto finishApply() -> void;
+
         protected:
             /**
              * @brief       Reimplements: QWidget::resizeEvent(QResizeEvent *event).
@@ -177,6 +618,194 @@ namespace Nedrysoft { namespace SettingsDialog {
              */
             auto addPage(ISettingsPage *page) -> SettingsPage *;
 
+            /**
+             * @brief       Adds a list of setting pages to the settings dialog.
+             *
+             * @note        Sections are located through an index, so the cost of adding pages grows linearly with
+             *              the number of pages.
+             *
+             * @param[in]   pages the list of ISettingsPage instances.
+             *
+             * @returns     the settings page structures, in the same order as the pages.
+             */
+            auto addPages(const QList<ISettingsPage *> &pages) -> QList<SettingsPage *>;
+
+            /**
+             * @brief       Adds a page to the dialog and connects its signals.
+             *
+             * @param[in]   page is a ISettingsPage instance.
+             *
+             * @returns     the settings page structure.
+             */
+            auto registerPage(ISettingsPage *page) -> SettingsPage *;
+
+            /**
+             * @brief       Processes the pages that have changed since the last batch.
+             */
+            auto processModifiedPages() -> void;
+
+            /**
+             * @brief       Adds pending pages until the slice budget is used, then schedules the next slice.
+             */
+            auto buildNextSlice() -> void;
+
+            /**
+             * @brief       Fixes the width of the navigation tree to fit the widest section name.
+             */
+            auto updateNavigationWidth() -> void;
+
+            /**
+             * @brief       Returns the descriptor for a page, creating it if the page has not been seen before.
+             *
+             * @note        The reference is only valid until the next descriptor is created.
+             *
+             * @param[in]   page the page.
+             *
+             * @returns     the page descriptor.
+             */
+            auto describePage(ISettingsPage *page) -> const PageDescriptor &;
+
+            /**
+             * @brief       Returns the id of an interned section or category name.
+             *
+             * @param[in]   name the name.
+             *
+             * @returns     the id of the name.
+             */
+            auto internName(const QString &name) -> int;
+
+            /**
+             * @brief       Creates the page widget(s) for a settings page if they have not already been created.
+             *
+             * @param[in]   settingsPage the settings page.
+             */
+            auto createPageWidget(SettingsPage *settingsPage) -> void;
+
+            /**
+             * @brief       Prepares a settings page for display, creating and resizing the widget as required.
+             *
+             * @param[in]   settingsPage the settings page.
+             */
+            auto showPage(SettingsPage *settingsPage) -> void;
+
+            /**
+             * @brief       Starts timing a page switch, the switch ends when the page is first painted.
+             *
+             * @param[in]   settingsPage the settings page being shown.
+             */
+            auto beginPageSwitch(SettingsPage *settingsPage) -> void;
+
+            /**
+             * @brief       Resizes a settings page to fit the dialog.
+             *
+             * @param[in]   settingsPage the settings page.
+             */
+            auto resizePage(SettingsPage *settingsPage) -> void;
+
+            /**
+             * @brief       Returns the settings page that is currently visible.
+             *
+             * @returns     the visible settings page; or nullptr if no page is visible.
+             */
+            auto visiblePage() -> SettingsPage *;
+
+            /**
+             * @brief       Releases the least recently shown page widgets until the memory budget is met.
+             *
+             * @param[in]   visiblePage the page being shown, which is never released.
+             */
+            auto evictPages(SettingsPage *visiblePage) -> void;
+
+            /**
+             * @brief       Saves the state of a page and destroys its widget.
+             *
+             * @param[in]   settingsPage the settings page.
+             *
+             * @returns     true if the widget was released; otherwise false.
+             */
+            auto evictPage(SettingsPage *settingsPage) -> bool;
+
+#if !defined(Q_OS_MACOS)
+            /**
+             * @brief       Displays a section in the stacked widget.
+             *
+             * @param[in]   section the section to display.
+             */
+            auto selectSection(SettingsSection *section) -> void;
+
+            /**
+             * @brief       Creates the tab widget for a section and moves the pages of the section into it.
+             *
+             * @param[in]   section the section.
+             */
+            auto createSectionTabs(SettingsSection *section) -> void;
+
+            /**
+             * @brief       Returns the page that is displayed when a section is selected.
+             *
+             * @param[in]   section the section.
+             *
+             * @returns     the settings page; or nullptr if the section has no pages.
+             */
+            auto sectionPage(SettingsSection *section) -> SettingsPage *;
+
+            /**
+             * @brief       Sets the page that is displayed when a section is selected.
+             *
+             * @param[in]   section the section.
+             * @param[in]   settingsPage the settings page, which must belong to the section.
+             */
+            auto setSectionPage(SettingsSection *section, SettingsPage *settingsPage) -> void;
+
+            /**
+             * @brief       Removes a section that no longer contains any pages.
+             *
+             * @param[in]   section the section to remove.
+             */
+            auto removeSection(SettingsSection *section) -> void;
+
+            /**
+             * @brief       Adds a page to the search index.
+             *
+             * @param[in]   page the page.
+             */
+            auto indexPage(ISettingsPage *page) -> void;
+
+            /**
+             * @brief       Hides the sections that do not match a search.
+             *
+             * @param[in]   text the search text.
+             */
+            auto filterSections(const QString &text) -> void;
+
+            /**
+             * @brief       Queues the sections either side of a section to be prefetched.
+             *
+             * @param[in]   section the section.
+             */
+            auto prefetchNeighbours(SettingsSection *section) -> void;
+
+            /**
+             * @brief       Queues the page that is shown when a section is selected to be prefetched.
+             *
+             * @param[in]   section the section.
+             * @param[in]   isUrgent true if the page should be created before other queued pages; otherwise false.
+             */
+            auto prefetchSection(SettingsSection *section, bool isUrgent) -> void;
+
+            /**
+             * @brief       Schedules the next prefetch slice if one is not already scheduled.
+             *
+             * @param[in]   delay the delay before the slice runs in milliseconds.
+             */
+            auto schedulePrefetch(int delay) -> void;
+
+            /**
+             * @brief       Creates queued pages until the prefetch budget is used.
+             */
+            auto prefetchNextSlice() -> void;
+#endif
+
             /**
              * @brief       Updates the stylesheet for light/dark mode.
              *
@@ -185,7 +814,16 @@ namespace Nedrysoft { namespace SettingsDialog {
              *
              * @returns     the style sheet.
              */
-            auto updateStyleSheet(const QString &styleSheet, bool isDarkMode) -> QString;
+            static auto updateStyleSheet(const QString &styleSheet, bool isDarkMode) -> QString;
+
+            /**
+             * @brief       Returns the precompiled dialog stylesheet for light/dark mode.
+             *
+             * @param[in]   isDarkMode true if dark mode; otherwise false.
+             *
+             * @returns     the style sheet.
+             */
+            static auto themeStyleSheet(bool isDarkMode) -> QString;
 
             /**
              * @brief       Updates the title & tool bars for light/dark mode theme changes.
@@ -198,6 +836,7 @@ namespace Nedrysoft { namespace SettingsDialog {
 #if defined(Q_OS_MACOS)
             Nedrysoft::MacHelper::MacToolbar *m_toolbar;
             QMap<Nedrysoft::MacHelper::MacToolbarItem *, SettingsPage *> m_pages;
+            QHash<QString, SettingsPage *> m_sections;
             int m_toolbarHeight;
             int m_maximumWidth;
             QParallelAnimationGroup *m_animationGroup;
@@ -205,19 +844,62 @@ namespace Nedrysoft { namespace SettingsDialog {
             QVBoxLayout *m_layout;
             QVBoxLayout *m_detailLayout;
             QHBoxLayout *m_mainLayout;
+            QVBoxLayout *m_navigationLayout;
+            QLineEdit *m_searchField;
+            SettingsSearchIndex *m_searchIndex;
             QHBoxLayout *m_controlsLayout;
-            QTreeWidget *m_treeWidget;
+            QListView *m_navigationView;
+            SettingsSectionModel *m_sectionModel;
             QStackedWidget *m_stackedWidget;
             QLabel *m_categoryLabel;
             QPushButton *m_okButton;
             QPushButton *m_cancelButton;
             QPushButton *m_applyButton;
+            QProgressBar *m_applyProgress;
+            QList<ISettingsPage *> m_applyQueue;
+            QList<QFutureWatcher<void> *> m_applyWatchers;
+            bool m_applyCancelled;
+            bool m_closeAfterApply;
             QList<SettingsPage *> m_pages;
+            QHash<QWidget *, SettingsPage *> m_containerPages;
+            QHash<QString, SettingsSection *> m_sections;
+            QList<SettingsSection *> m_sectionList;
+            SettingsSection *m_currentSection;
+            QList<ISettingsPage *> m_pendingPages;
+            int m_navigationWidth;
+            QHash<ISettingsPage *, SettingsPage *> m_settingsPages;
+            QList<SettingsPage *> m_recentPages;
+            qint64 m_memoryUsage;
+            qint64 m_memoryBudget;
+            QList<SettingsPage *> m_prefetchQueue;
+            int m_prefetchBudget;
+            bool m_isPrefetchScheduled;
 #endif
             SettingsPage *m_currentPage;
+            Options m_options;
+            int m_buildSliceBudget;
+            bool m_isClosed;
+            QSet<ISettingsPage *> m_dirtyPages;
+            QSet<ISettingsPage *> m_modifiedPages;
+            QHash<ISettingsPage *, int> m_modificationCounts;
+            QTimer *m_modifiedTimer;
+            QVector<PageDescriptor> m_descriptors;
+            QHash<ISettingsPage *, int> m_descriptorIndex;
+            QStringList m_names;
+            QHash<QString, int> m_nameIds;
+            QThreadPool *m_validationPool;
+            SettingsIconCache *m_iconCache;
+            SettingsTracer *m_tracer;
+            QWidget *m_pageSwitchWidget;
+            ISettingsPage *m_pageSwitchPage;
+            qint64 m_pageSwitchStart;
+            SettingsSnapshot *m_snapshot;
+            SettingsStore *m_settingsStore;
 
             //! @endcond
     };
 }}
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(Nedrysoft::SettingsDialog::SettingsDialog::Options)
+
 #endif // NEDRYSOFT_SETTINGSDIALOG_H
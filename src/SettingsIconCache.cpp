@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of the Nedrysoft SettingsDialog. (https://github.com/nedrysoft/SettingsDialog)
+ *
+ * A cross-platform settings dialog
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SettingsIconCache.h"
+
+#include "ISettingsPage.h"
+#include "SettingsTracer.h"
+
+#include <QPixmap>
+
+Nedrysoft::SettingsDialog::SettingsIconCache::SettingsIconCache() :
+        m_tracer(nullptr) {
+
+}
+
+auto Nedrysoft::SettingsDialog::SettingsIconCache::icon(
+        ISettingsPage *page,
+        int size,
+        bool isDarkMode,
+        qreal devicePixelRatio) -> QIcon {
+
+    auto &entry = m_entries[qMakePair(page, size)];
+    auto themeIndex = isDarkMode ? 1 : 0;
+
+    if (qFuzzyCompare(entry.m_devicePixelRatio[themeIndex], devicePixelRatio)) {
+        return entry.m_icon[themeIndex];
+    }
+
+    // the icon is rasterised once here so that painting does not need to render the source (i.e svg) again
+
+    auto pixelSize = qRound(size*devicePixelRatio);
+    auto start = m_tracer ? m_tracer->timestamp() : 0;
+    auto pixmap = page->icon(isDarkMode).pixmap(QSize(pixelSize, pixelSize));
+
+    if (m_tracer) {
+        m_tracer->record("icon", page, start);
+    }
+
+    pixmap.setDevicePixelRatio(devicePixelRatio);
+
+    entry.m_icon[themeIndex] = QIcon(pixmap);
+    entry.m_devicePixelRatio[themeIndex] = devicePixelRatio;
+
+    return entry.m_icon[themeIndex];
+}
+
+auto Nedrysoft::SettingsDialog::SettingsIconCache::remove(ISettingsPage *page) -> void {
+    auto iterator = m_entries.begin();
+
+    while (iterator!=m_entries.end()) {
+        if (iterator.key().first==page) {
+            iterator = m_entries.erase(iterator);
+        } else {
+            ++iterator;
+        }
+    }
+}
+
+auto Nedrysoft::SettingsDialog::SettingsIconCache::clear() -> void {
+    m_entries.clear();
+}
+
+auto Nedrysoft::SettingsDialog::SettingsIconCache::setTracer(SettingsTracer *tracer) -> void {
+    m_tracer = tracer;
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of the Nedrysoft SettingsDialog. (https://github.com/nedrysoft/SettingsDialog)
+ *
+ * A cross-platform settings dialog
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NEDRYSOFT_SETTINGSICONCACHE_H
+#define NEDRYSOFT_SETTINGSICONCACHE_H
+
+#include <QHash>
+#include <QIcon>
+#include <QPair>
+
+namespace Nedrysoft { namespace SettingsDialog {
+    class ISettingsPage;
+    class SettingsTracer;
+
+    /**
+     * @brief       The SettingsIconCache class holds pre-rendered light and dark icons for settings pages.
+     *
+     * @details     Each icon is requested from the page once per theme and rendered to a pixmap at the requested
+     *              size and device pixel ratio, later lookups are served from the cache without calling the page.
+     */
+    class SettingsIconCache {
+        public:
+            /**
+             * @brief       Constructs a new SettingsIconCache.
+             */
+            SettingsIconCache();
+
+            /**
+             * @brief       Returns the icon for a page.
+             *
+             * @param[in]   page the page.
+             * @param[in]   size the logical size of the icon in pixels.
+             * @param[in]   isDarkMode true to return the dark mode icon; otherwise false.
+             * @param[in]   devicePixelRatio the device pixel ratio the icon is rendered at.
+             *
+             * @returns     the rendered icon.
+             */
+            auto icon(ISettingsPage *page, int size, bool isDarkMode, qreal devicePixelRatio=1) -> QIcon;
+
+            /**
+             * @brief       Removes all cached icons for a page.
+             *
+             * @param[in]   page the page.
+             */
+            auto remove(ISettingsPage *page) -> void;
+
+            /**
+             * @brief       Removes all cached icons.
+             */
+            auto clear() -> void;
+
+            /**
+             * @brief       Sets the tracer used to time the icon requests made to pages.
+             *
+             * @param[in]   tracer the tracer; or nullptr to disable tracing.
+             */
+            auto setTracer(SettingsTracer *tracer) -> void;
+
+        private:
+            /**
+             * @brief       The Entry class holds the rendered icons for a page at a given size.
+             */
+            class Entry {
+                public:
+                    Entry() :
+                        m_devicePixelRatio{0, 0} {
+
+                        }
+
+                public:
+                    //! @cond
+
+                    QIcon m_icon[2];
+                    qreal m_devicePixelRatio[2];
+
+                    //! @endcond
+            };
+
+        private:
+            //! @cond
+
+            QHash<QPair<ISettingsPage *, int>, Entry> m_entries;
+            SettingsTracer *m_tracer;
+
+            //! @endcond
+    };
+}}
+
+#endif // NEDRYSOFT_SETTINGSICONCACHE_H
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of the Nedrysoft SettingsDialog. (https://github.com/nedrysoft/SettingsDialog)
+ *
+ * A cross-platform settings dialog
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SettingsSearchIndex.h"
+
+#include <QRegularExpression>
+
+#include <algorithm>
+#include <climits>
+
+constexpr auto TrigramLength = 3;
+
+Nedrysoft::SettingsDialog::SettingsSearchIndex::SettingsSearchIndex() :
+        m_isSorted(true) {
+
+}
+
+auto Nedrysoft::SettingsDialog::SettingsSearchIndex::words(const QString &text) -> QStringList {
+    static const QRegularExpression separator(R"([^\w]+)", QRegularExpression::UseUnicodePropertiesOption);
+
+    return text.toLower().split(separator, Qt::SkipEmptyParts);
+}
+
+auto Nedrysoft::SettingsDialog::SettingsSearchIndex::addDocument(int id, const QString &text) -> void {
+    if (m_documents.contains(id)) {
+        removeDocument(id);
+    }
+
+    auto documentWords = words(text);
+    auto documentText = documentWords.join(" ");
+
+    m_documents[id] = documentText;
+
+    for (auto position=0;position<=documentText.length()-TrigramLength;position++) {
+        m_trigrams[documentText.mid(position, TrigramLength)].insert(id);
+    }
+
+    documentWords.removeDuplicates();
+
+    for (const auto &word : documentWords) {
+        m_words.append(qMakePair(word, id));
+    }
+
+    // the word list is sorted on the next search, so adding many documents only sorts once
+
+    m_isSorted = false;
+}
+
+auto Nedrysoft::SettingsDialog::SettingsSearchIndex::removeDocument(int id) -> void {
+    if (!m_documents.contains(id)) {
+        return;
+    }
+
+    auto documentText = m_documents.take(id);
+
+    for (auto position=0;position<=documentText.length()-TrigramLength;position++) {
+        auto trigram = m_trigrams.find(documentText.mid(position, TrigramLength));
+
+        if (trigram!=m_trigrams.end()) {
+            trigram->remove(id);
+
+            if (trigram->isEmpty()) {
+                m_trigrams.erase(trigram);
+            }
+        }
+    }
+
+    m_words.erase(std::remove_if(m_words.begin(), m_words.end(), [id](const QPair<QString, int> &word) {
+        return word.second==id;
+    }), m_words.end());
+}
+
+auto Nedrysoft::SettingsDialog::SettingsSearchIndex::search(const QString &query) -> QSet<int> {
+    auto terms = words(query);
+
+    if (terms.isEmpty()) {
+        auto documentIds = m_documents.keys();
+
+        return QSet<int>(documentIds.begin(), documentIds.end());
+    }
+
+    QSet<int> results;
+
+    for (auto termIndex=0;termIndex<terms.count();termIndex++) {
+        const auto &term = terms.at(termIndex);
+
+        auto termResults = (term.length()<TrigramLength) ? prefixSearch(term) : trigramSearch(term);
+
+        if (termIndex==0) {
+            results = termResults;
+        } else {
+            results.intersect(termResults);
+        }
+
+        if (results.isEmpty()) {
+            break;
+        }
+    }
+
+    return results;
+}
+
+auto Nedrysoft::SettingsDialog::SettingsSearchIndex::prefixSearch(const QString &prefix) -> QSet<int> {
+    if (!m_isSorted) {
+        std::sort(m_words.begin(), m_words.end());
+
+        m_isSorted = true;
+    }
+
+    QSet<int> results;
+
+    auto word = std::lower_bound(m_words.cbegin(), m_words.cend(), qMakePair(prefix, INT_MIN));
+
+    while ((word!=m_words.cend()) && (word->first.startsWith(prefix))) {
+        results.insert(word->second);
+
+        ++word;
+    }
+
+    return results;
+}
+
+auto Nedrysoft::SettingsDialog::SettingsSearchIndex::trigramSearch(const QString &term) -> QSet<int> {
+    QSet<int> candidates;
+
+    for (auto position=0;position<=term.length()-TrigramLength;position++) {
+        auto trigram = m_trigrams.constFind(term.mid(position, TrigramLength));
+
+        if (trigram==m_trigrams.cend()) {
+            return QSet<int>();
+        }
+
+        if (position==0) {
+            candidates = *trigram;
+        } else {
+            candidates.intersect(*trigram);
+        }
+
+        if (candidates.isEmpty()) {
+            return candidates;
+        }
+    }
+
+    // sharing every trigram does not guarantee that the trigrams are adjacent, so the candidates are confirmed
+
+    QSet<int> results;
+
+    for (auto id : candidates) {
+        if (m_documents.value(id).contains(term)) {
+            results.insert(id);
+        }
+    }
+
+    return results;
+}
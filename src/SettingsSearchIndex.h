@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of the Nedrysoft SettingsDialog. (https://github.com/nedrysoft/SettingsDialog)
+ *
+ * A cross-platform settings dialog
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NEDRYSOFT_SETTINGSSEARCHINDEX_H
+#define NEDRYSOFT_SETTINGSSEARCHINDEX_H
+
+#include <QHash>
+#include <QPair>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace Nedrysoft { namespace SettingsDialog {
+    /**
+     * @brief       The SettingsSearchIndex class is an in memory text index used to search the settings pages.
+     *
+     * @details     Each document is identified by an integer id and is stored as a normalised (lower case) text.
+     *              Terms shorter than three characters are matched against the start of the words in a document
+     *              using a sorted word list, longer terms are matched anywhere in a document by intersecting the
+     *              documents that contain each trigram of the term before confirming the match.
+     */
+    class SettingsSearchIndex {
+        public:
+            /**
+             * @brief       Constructs a new empty SettingsSearchIndex.
+             */
+            SettingsSearchIndex();
+
+            /**
+             * @brief       Adds a document to the index, replacing the text if the id is already indexed.
+             *
+             * @param[in]   id the id of the document.
+             * @param[in]   text the text of the document.
+             */
+            auto addDocument(int id, const QString &text) -> void;
+
+            /**
+             * @brief       Removes a document from the index.
+             *
+             * @param[in]   id the id of the document.
+             */
+            auto removeDocument(int id) -> void;
+
+            /**
+             * @brief       Returns the documents that match a query.
+             *
+             * @note        A document matches if it matches every whitespace separated term in the query.
+             *
+             * @param[in]   query the query.
+             *
+             * @returns     the ids of the matching documents.
+             */
+            auto search(const QString &query) -> QSet<int>;
+
+        private:
+            /**
+             * @brief       Returns the lower case words in a text.
+             *
+             * @param[in]   text the text.
+             *
+             * @returns     the list of words.
+             */
+            static auto words(const QString &text) -> QStringList;
+
+            /**
+             * @brief       Returns the documents that contain a word starting with a prefix.
+             *
+             * @param[in]   prefix the normalised prefix.
+             *
+             * @returns     the ids of the matching documents.
+             */
+            auto prefixSearch(const QString &prefix) -> QSet<int>;
+
+            /**
+             * @brief       Returns the documents that contain a term.
+             *
+             * @param[in]   term the normalised term, at least three characters long.
+             *
+             * @returns     the ids of the matching documents.
+             */
+            auto trigramSearch(const QString &term) -> QSet<int>;
+
+        private:
+            //! @cond
+
+            QHash<int, QString> m_documents;
+            QHash<QString, QSet<int>> m_trigrams;
+            QVector<QPair<QString, int>> m_words;
+            bool m_isSorted;
+
+            //! @endcond
+    };
+}}
+
+#endif // NEDRYSOFT_SETTINGSSEARCHINDEX_H
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of the Nedrysoft SettingsDialog. (https://github.com/nedrysoft/SettingsDialog)
+ *
+ * A cross-platform settings dialog
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SettingsSectionModel.h"
+
+#include "SettingsDialog.h"
+#include "SettingsIconCache.h"
+
+#include <QAbstractItemView>
+
+Nedrysoft::SettingsDialog::SettingsSectionModel::SettingsSectionModel(
+        const QList<SettingsSection *> &sections,
+        SettingsIconCache *iconCache,
+        bool isDarkMode,
+        QAbstractItemView *view) :
+
+        QAbstractListModel(view),
+        m_sections(sections),
+        m_iconCache(iconCache),
+        m_view(view),
+        m_isDarkMode(isDarkMode) {
+
+}
+
+auto Nedrysoft::SettingsDialog::SettingsSectionModel::rowCount(const QModelIndex &parent) const -> int {
+    if (parent.isValid()) {
+        return 0;
+    }
+
+    return m_sections.count();
+}
+
+auto Nedrysoft::SettingsDialog::SettingsSectionModel::data(const QModelIndex &index, int role) const -> QVariant {
+    if ((!index.isValid()) || (index.row()>=m_sections.count())) {
+        return QVariant();
+    }
+
+    auto section = m_sections.at(index.row());
+
+    switch(role) {
+        case Qt::DisplayRole: {
+            return section->m_name;
+        }
+
+        case Qt::DecorationRole: {
+            if (section->m_pages.isEmpty()) {
+                return QVariant();
+            }
+
+            // the icon is rendered at the size the view draws it, so the cache entry is shared with the dialog
+
+            return m_iconCache->icon(
+                    section->m_pages.first()->m_pageSettings,
+                    m_view->iconSize().width(),
+                    m_isDarkMode,
+                    m_view->devicePixelRatioF());
+        }
+
+        case Qt::ToolTipRole: {
+            if (section->m_pages.isEmpty()) {
+                return QVariant();
+            }
+
+            return section->m_pages.first()->m_description;
+        }
+
+        case Qt::UserRole: {
+            return QVariant::fromValue(section->m_widget);
+        }
+
+        default: {
+            return QVariant();
+        }
+    }
+}
+
+auto Nedrysoft::SettingsDialog::SettingsSectionModel::beginAddSection() -> void {
+    beginInsertRows(QModelIndex(), m_sections.count(), m_sections.count());
+}
+
+auto Nedrysoft::SettingsDialog::SettingsSectionModel::endAddSection() -> void {
+    endInsertRows();
+}
+
+auto Nedrysoft::SettingsDialog::SettingsSectionModel::beginRemoveSection(int row) -> void {
+    beginRemoveRows(QModelIndex(), row, row);
+}
+
+auto Nedrysoft::SettingsDialog::SettingsSectionModel::endRemoveSection() -> void {
+    endRemoveRows();
+}
+
+auto Nedrysoft::SettingsDialog::SettingsSectionModel::sectionChanged(int row) -> void {
+    if ((row<0) || (row>=m_sections.count())) {
+        return;
+    }
+
+    Q_EMIT dataChanged(index(row), index(row));
+}
+
+auto Nedrysoft::SettingsDialog::SettingsSectionModel::setDarkMode(bool isDarkMode) -> void {
+    if (m_isDarkMode==isDarkMode) {
+        return;
+    }
+
+    m_isDarkMode = isDarkMode;
+
+    if (!m_sections.isEmpty()) {
+        Q_EMIT dataChanged(index(0), index(m_sections.count()-1), {Qt::DecorationRole});
+    }
+}
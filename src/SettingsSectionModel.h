@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of the Nedrysoft SettingsDialog. (https://github.com/nedrysoft/SettingsDialog)
+ *
+ * A cross-platform settings dialog
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NEDRYSOFT_SETTINGSSECTIONMODEL_H
+#define NEDRYSOFT_SETTINGSSECTIONMODEL_H
+
+#include <QAbstractListModel>
+#include <QList>
+
+class QAbstractItemView;
+
+namespace Nedrysoft { namespace SettingsDialog {
+    class SettingsIconCache;
+    class SettingsSection;
+
+    /**
+     * @brief       The SettingsSectionModel class is the model used by the navigation pane.
+     *
+     * @details     The model does not copy any data, each row is read directly from the section list of the dialog.
+     *              The dialog brackets changes to the list with the begin/end functions so that the view is kept up
+     *              to date.  Icons are fetched from the icon cache when a row is painted.
+     */
+    class SettingsSectionModel :
+            public QAbstractListModel {
+
+        private:
+            Q_OBJECT
+
+        public:
+            /**
+             * @brief       Constructs a new SettingsSectionModel.
+             *
+             * @param[in]   sections the section list of the dialog, which must outlive the model.
+             * @param[in]   iconCache the cache that icons are fetched from.
+             * @param[in]   isDarkMode true if icons should be the dark mode variant; otherwise false.
+             * @param[in]   view the view that displays the model, which also becomes the parent of the model.
+             */
+            SettingsSectionModel(
+                    const QList<SettingsSection *> &sections,
+                    SettingsIconCache *iconCache,
+                    bool isDarkMode,
+                    QAbstractItemView *view);
+
+            /**
+             * @brief       Reimplements: QAbstractItemModel::rowCount(const QModelIndex &parent).
+             *
+             * @param[in]   parent the parent index.
+             *
+             * @returns     the number of sections.
+             */
+            auto rowCount(const QModelIndex &parent=QModelIndex()) const -> int override;
+
+            /**
+             * @brief       Reimplements: QAbstractItemModel::data(const QModelIndex &index, int role).
+             *
+             * @param[in]   index the index of the section.
+             * @param[in]   role the data role.
+             *
+             * @returns     the data for the role.
+             */
+            auto data(const QModelIndex &index, int role=Qt::DisplayRole) const -> QVariant override;
+
+            /**
+             * @brief       Must be called before a section is appended to the section list.
+             */
+            auto beginAddSection() -> void;
+
+            /**
+             * @brief       Must be called after a section has been appended to the section list.
+             */
+            auto endAddSection() -> void;
+
+            /**
+             * @brief       Must be called before a section is removed from the section list.
+             *
+             * @param[in]   row the row of the section.
+             */
+            auto beginRemoveSection(int row) -> void;
+
+            /**
+             * @brief       Must be called after a section has been removed from the section list.
+             */
+            auto endRemoveSection() -> void;
+
+            /**
+             * @brief       Notifies the view that the data of a section has changed.
+             *
+             * @param[in]   row the row of the section.
+             */
+            auto sectionChanged(int row) -> void;
+
+            /**
+             * @brief       Sets the theme used for the icons.
+             *
+             * @note        Only the rows that are visible fetch their icon again.
+             *
+             * @param[in]   isDarkMode true if dark mode; otherwise false.
+             */
+            auto setDarkMode(bool isDarkMode) -> void;
+
+        private:
+            //! @cond
+
+            const QList<SettingsSection *> &m_sections;
+            SettingsIconCache *m_iconCache;
+            QAbstractItemView *m_view;
+            bool m_isDarkMode;
+
+            //! @endcond
+    };
+}}
+
+#endif // NEDRYSOFT_SETTINGSSECTIONMODEL_H
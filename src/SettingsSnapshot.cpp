@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of the Nedrysoft SettingsDialog. (https://github.com/nedrysoft/SettingsDialog)
+ *
+ * A cross-platform settings dialog
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SettingsSnapshot.h"
+
+#include "ISettingsPage.h"
+
+auto Nedrysoft::SettingsDialog::SettingsSnapshot::capture(ISettingsPage *page) -> bool {
+    auto values = page->snapshotSettings();
+
+    if (values.isEmpty()) {
+        m_values.remove(page);
+
+        return false;
+    }
+
+    m_values[page] = values;
+
+    return true;
+}
+
+auto Nedrysoft::SettingsDialog::SettingsSnapshot::contains(ISettingsPage *page) const -> bool {
+    return m_values.contains(page);
+}
+
+auto Nedrysoft::SettingsDialog::SettingsSnapshot::values(ISettingsPage *page) const -> QVariantMap {
+    return m_values.value(page);
+}
+
+auto Nedrysoft::SettingsDialog::SettingsSnapshot::changes(ISettingsPage *page) const -> QVariantMap {
+    auto snapshot = m_values.value(page);
+    auto current = page->snapshotSettings();
+
+    QVariantMap changes;
+
+    for (auto iterator=current.cbegin();iterator!=current.cend();++iterator) {
+        auto value = snapshot.constFind(iterator.key());
+
+        if ((value==snapshot.cend()) || (value.value()!=iterator.value())) {
+            changes.insert(iterator.key(), iterator.value());
+        }
+    }
+
+    return changes;
+}
+
+auto Nedrysoft::SettingsDialog::SettingsSnapshot::commit(ISettingsPage *page, const QVariantMap &values) -> void {
+    if (values.isEmpty()) {
+        m_values.remove(page);
+
+        return;
+    }
+
+    m_values[page] = values;
+}
+
+auto Nedrysoft::SettingsDialog::SettingsSnapshot::remove(ISettingsPage *page) -> void {
+    m_values.remove(page);
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of the Nedrysoft SettingsDialog. (https://github.com/nedrysoft/SettingsDialog)
+ *
+ * A cross-platform settings dialog
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NEDRYSOFT_SETTINGSSNAPSHOT_H
+#define NEDRYSOFT_SETTINGSSNAPSHOT_H
+
+#include <QHash>
+#include <QVariantMap>
+
+namespace Nedrysoft { namespace SettingsDialog {
+    class ISettingsPage;
+
+    /**
+     * @brief       The SettingsSnapshot class holds the last committed values of the transactional pages.
+     *
+     * @details     A page is transactional if ISettingsPage::snapshotSettings() returns any values.  The values
+     *              of each page are held in an implicitly shared QVariantMap, so taking a snapshot does not copy
+     *              the values.
+     */
+    class SettingsSnapshot {
+        public:
+            /**
+             * @brief       Records the current values of a page.
+             *
+             * @param[in]   page the page.
+             *
+             * @returns     true if the page is transactional; otherwise false.
+             */
+            auto capture(ISettingsPage *page) -> bool;
+
+            /**
+             * @brief       Returns whether a snapshot is held for a page.
+             *
+             * @param[in]   page the page.
+             *
+             * @returns     true if the page is transactional; otherwise false.
+             */
+            auto contains(ISettingsPage *page) const -> bool;
+
+            /**
+             * @brief       Returns the values recorded for a page.
+             *
+             * @param[in]   page the page.
+             *
+             * @returns     the recorded values.
+             */
+            auto values(ISettingsPage *page) const -> QVariantMap;
+
+            /**
+             * @brief       Returns the values of a page that differ from the snapshot.
+             *
+             * @param[in]   page the page.
+             *
+             * @returns     the changed keys and their current values.
+             */
+            auto changes(ISettingsPage *page) const -> QVariantMap;
+
+            /**
+             * @brief       Records the values of a page that have been committed.
+             *
+             * @details     The values replace the snapshot of the page, so a setting that the page no longer
+             *              returns is not restored by a later rollback.
+             *
+             * @param[in]   page the page.
+             * @param[in]   values the values returned by snapshotSettings() when the page was committed.
+             */
+            auto commit(ISettingsPage *page, const QVariantMap &values) -> void;
+
+            /**
+             * @brief       Removes the snapshot of a page.
+             *
+             * @param[in]   page the page.
+             */
+            auto remove(ISettingsPage *page) -> void;
+
+        private:
+            //! @cond
+
+            QHash<ISettingsPage *, QVariantMap> m_values;
+
+            //! @endcond
+    };
+}}
+
+#endif // NEDRYSOFT_SETTINGSSNAPSHOT_H
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of the Nedrysoft SettingsDialog. (https://github.com/nedrysoft/SettingsDialog)
+ *
+ * A cross-platform settings dialog
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SettingsStore.h"
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+Nedrysoft::SettingsDialog::SettingsStore::SettingsStore(const QString &filename, QObject *parent) :
+        QObject(parent),
+        m_filename(filename) {
+
+}
+
+auto Nedrysoft::SettingsDialog::SettingsStore::filename() const -> QString {
+    return m_filename;
+}
+
+auto Nedrysoft::SettingsDialog::SettingsStore::load() -> bool {
+    QMutexLocker locker(&m_mutex);
+
+    m_pendingValues.clear();
+    m_removedKeys.clear();
+
+    QFile file(m_filename);
+
+    if (!file.exists()) {
+        m_values.clear();
+
+        return true;
+    }
+
+    if (!file.open(QFile::ReadOnly)) {
+        return false;
+    }
+
+    QJsonParseError parseError;
+
+    auto document = QJsonDocument::fromJson(file.readAll(), &parseError);
+
+    if ((parseError.error!=QJsonParseError::NoError) || (!document.isObject())) {
+        return false;
+    }
+
+    m_values = document.object().toVariantMap();
+
+    return true;
+}
+
+auto Nedrysoft::SettingsDialog::SettingsStore::value(const QString &key, const QVariant &defaultValue) -> QVariant {
+    QMutexLocker locker(&m_mutex);
+
+    if (m_pendingValues.contains(key)) {
+        return m_pendingValues.value(key);
+    }
+
+    if (m_removedKeys.contains(key)) {
+        return defaultValue;
+    }
+
+    return m_values.value(key, defaultValue);
+}
+
+auto Nedrysoft::SettingsDialog::SettingsStore::setValue(const QString &key, const QVariant &value) -> void {
+    QMutexLocker locker(&m_mutex);
+
+    m_removedKeys.remove(key);
+    m_pendingValues.insert(key, value);
+}
+
+auto Nedrysoft::SettingsDialog::SettingsStore::remove(const QString &key) -> void {
+    QMutexLocker locker(&m_mutex);
+
+    m_pendingValues.remove(key);
+    m_removedKeys.insert(key);
+}
+
+auto Nedrysoft::SettingsDialog::SettingsStore::hasPendingChanges() -> bool {
+    QMutexLocker locker(&m_mutex);
+
+    return (!m_pendingValues.isEmpty()) || (!m_removedKeys.isEmpty());
+}
+
+auto Nedrysoft::SettingsDialog::SettingsStore::flush() -> bool {
+    QMutexLocker locker(&m_mutex);
+
+    if ((m_pendingValues.isEmpty()) && (m_removedKeys.isEmpty())) {
+        return true;
+    }
+
+    auto values = m_values;
+
+    for (const auto &key : m_removedKeys) {
+        values.remove(key);
+    }
+
+    for (auto iterator=m_pendingValues.cbegin();iterator!=m_pendingValues.cend();++iterator) {
+        values.insert(iterator.key(), iterator.value());
+    }
+
+    // QSaveFile writes to a temporary file and renames it over the settings file when committed, so the file
+    // on disk holds either the previous settings or the new settings
+
+    QSaveFile file(m_filename);
+
+    if (!file.open(QFile::WriteOnly)) {
+        return false;
+    }
+
+    file.write(QJsonDocument(QJsonObject::fromVariantMap(values)).toJson());
+
+    if (!file.commit()) {
+        return false;
+    }
+
+    m_values = values;
+
+    m_pendingValues.clear();
+    m_removedKeys.clear();
+
+    return true;
+}
+
+auto Nedrysoft::SettingsDialog::SettingsStore::discard() -> void {
+    QMutexLocker locker(&m_mutex);
+
+    m_pendingValues.clear();
+    m_removedKeys.clear();
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of the Nedrysoft SettingsDialog. (https://github.com/nedrysoft/SettingsDialog)
+ *
+ * A cross-platform settings dialog
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NEDRYSOFT_SETTINGSSTORE_H
+#define NEDRYSOFT_SETTINGSSTORE_H
+
+#include "SettingsDialogSpec.h"
+
+#include <QMutex>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QVariant>
+#include <QVariantMap>
+
+namespace Nedrysoft { namespace SettingsDialog {
+    /**
+     * @brief       The SettingsStore class is a settings file shared by the pages of a dialog.
+     *
+     * @details     Pages write their settings into the store from ISettingsPage::acceptSettings(), the changes
+     *              are held in memory until the dialog has accepted every page and then written to disk with a
+     *              single atomic write (a temporary file that replaces the settings file), so an apply is never
+     *              left partly saved.  The settings are stored as a JSON object keyed by setting name.
+     *
+     *              Values can be read and written from any thread, which allows the store to be used from
+     *              ISettingsPage::acceptSettingsAsync().
+     */
+    class SETTINGS_DIALOG_DLLSPEC SettingsStore :
+            public QObject {
+
+        private:
+            Q_OBJECT
+
+        public:
+            /**
+             * @brief       Constructs a new SettingsStore.
+             *
+             * @param[in]   filename the name of the settings file.
+             * @param[in]   parent the owner of the store.
+             */
+            explicit SettingsStore(const QString &filename, QObject *parent=nullptr);
+
+            /**
+             * @brief       Returns the name of the settings file.
+             *
+             * @returns     the filename.
+             */
+            auto filename() const -> QString;
+
+            /**
+             * @brief       Reads the settings file, discarding any changes that have not been flushed.
+             *
+             * @note        A settings file that does not exist is treated as empty.
+             *
+             * @returns     true if the settings were read; otherwise false.
+             */
+            auto load() -> bool;
+
+            /**
+             * @brief       Returns the value of a setting, including changes that have not been flushed.
+             *
+             * @param[in]   key the name of the setting.
+             * @param[in]   defaultValue the value returned if the setting does not exist.
+             *
+             * @returns     the value of the setting.
+             */
+            auto value(const QString &key, const QVariant &defaultValue=QVariant()) -> QVariant;
+
+            /**
+             * @brief       Sets the value of a setting.
+             *
+             * @param[in]   key the name of the setting.
+             * @param[in]   value the value, which must be convertible to JSON.
+             */
+            auto setValue(const QString &key, const QVariant &value) -> void;
+
+            /**
+             * @brief       Removes a setting.
+             *
+             * @param[in]   key the name of the setting.
+             */
+            auto remove(const QString &key) -> void;
+
+            /**
+             * @brief       Returns whether there are changes that have not been flushed.
+             *
+             * @returns     true if there are pending changes; otherwise false.
+             */
+            auto hasPendingChanges() -> bool;
+
+            /**
+             * @brief       Writes the pending changes to the settings file.
+             *
+             * @note        If the write fails the settings file is left unchanged and the changes remain pending.
+             *
+             * @returns     true if the settings file is up to date; otherwise false.
+             */
+            auto flush() -> bool;
+
+            /**
+             * @brief       Discards the changes that have not been flushed.
+             */
+            auto discard() -> void;
+
+        private:
+            //! @cond
+
+            QString m_filename;
+            QMutex m_mutex;
+            QVariantMap m_values;
+            QVariantMap m_pendingValues;
+            QSet<QString> m_removedKeys;
+
+            //! @endcond
+    };
+}}
+
+#endif // NEDRYSOFT_SETTINGSSTORE_H
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of the Nedrysoft SettingsDialog. (https://github.com/nedrysoft/SettingsDialog)
+ *
+ * A cross-platform settings dialog
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SettingsTracer.h"
+
+#include "SettingsDialog.h"
+
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QThread>
+
+constexpr auto NanosecondsPerMicrosecond = 1000.0;
+
+Nedrysoft::SettingsDialog::SettingsTracer::SettingsTracer() {
+    m_timer.start();
+}
+
+auto Nedrysoft::SettingsDialog::SettingsTracer::timestamp() const -> qint64 {
+    return m_timer.nsecsElapsed();
+}
+
+auto Nedrysoft::SettingsDialog::SettingsTracer::setPageName(ISettingsPage *page, const QString &name) -> void {
+    QMutexLocker locker(&m_mutex);
+
+    m_pageNames[page] = name;
+}
+
+auto Nedrysoft::SettingsDialog::SettingsTracer::removePage(ISettingsPage *page) -> void {
+    QMutexLocker locker(&m_mutex);
+
+    m_pageNames.remove(page);
+}
+
+auto Nedrysoft::SettingsDialog::SettingsTracer::record(const QString &name, ISettingsPage *page, qint64 start) -> void {
+    TraceEvent event;
+
+    event.m_duration = m_timer.nsecsElapsed()-start;
+    event.m_start = start;
+    event.m_name = name;
+    event.m_threadId = reinterpret_cast<quintptr>(QThread::currentThreadId());
+
+    QMutexLocker locker(&m_mutex);
+
+    if (page) {
+        event.m_page = m_pageNames.value(page);
+    }
+
+    m_events.append(event);
+}
+
+auto Nedrysoft::SettingsDialog::SettingsTracer::events() -> QVector<TraceEvent> {
+    QMutexLocker locker(&m_mutex);
+
+    return m_events;
+}
+
+auto Nedrysoft::SettingsDialog::SettingsTracer::clear() -> void {
+    QMutexLocker locker(&m_mutex);
+
+    m_events.clear();
+}
+
+auto Nedrysoft::SettingsDialog::SettingsTracer::toChromeTrace() -> QByteArray {
+    QJsonArray traceEvents;
+
+    // thread ids are not meaningful outside the process, so they are numbered in the order they are first seen
+
+    QHash<quintptr, int> threadNumbers;
+
+    for (const auto &event : events()) {
+        auto threadNumber = threadNumbers.value(event.m_threadId, -1);
+
+        if (threadNumber<0) {
+            threadNumber = threadNumbers.count();
+
+            threadNumbers[event.m_threadId] = threadNumber;
+        }
+
+        QJsonObject traceEvent;
+
+        traceEvent["name"] = event.m_page.isEmpty() ? event.m_name : QString("%1 (%2)").arg(event.m_name).arg(event.m_page);
+        traceEvent["cat"] = event.m_name;
+        traceEvent["ph"] = "X";
+        traceEvent["ts"] = static_cast<double>(event.m_start)/NanosecondsPerMicrosecond;
+        traceEvent["dur"] = static_cast<double>(event.m_duration)/NanosecondsPerMicrosecond;
+        traceEvent["pid"] = static_cast<double>(QCoreApplication::applicationPid());
+        traceEvent["tid"] = threadNumber;
+
+        if (!event.m_page.isEmpty()) {
+            traceEvent["args"] = QJsonObject{{"page", event.m_page}};
+        }
+
+        traceEvents.append(traceEvent);
+    }
+
+    QJsonObject trace;
+
+    trace["traceEvents"] = traceEvents;
+    trace["displayTimeUnit"] = "ms";
+
+    return QJsonDocument(trace).toJson(QJsonDocument::Compact);
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2020 Adrian Carpenter
+ *
+ * This file is part of the Nedrysoft SettingsDialog. (https://github.com/nedrysoft/SettingsDialog)
+ *
+ * A cross-platform settings dialog
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NEDRYSOFT_SETTINGSTRACER_H
+#define NEDRYSOFT_SETTINGSTRACER_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+namespace Nedrysoft { namespace SettingsDialog {
+    class ISettingsPage;
+    class TraceEvent;
+
+    /**
+     * @brief       The SettingsTracer class records the time spent in calls made by the dialog.
+     *
+     * @details     Timestamps are measured from when the tracer was created.  Events can be recorded from any
+     *              thread, which allows validation performed on the thread pool to be traced.
+     */
+    class SettingsTracer {
+        public:
+            /**
+             * @brief       Constructs a new SettingsTracer.
+             */
+            SettingsTracer();
+
+            /**
+             * @brief       Returns the current time used to mark the start of an event.
+             *
+             * @returns     the time in nanoseconds since the tracer was created.
+             */
+            auto timestamp() const -> qint64;
+
+            /**
+             * @brief       Sets the name that identifies a page in the recorded events.
+             *
+             * @param[in]   page the page.
+             * @param[in]   name the name of the page.
+             */
+            auto setPageName(ISettingsPage *page, const QString &name) -> void;
+
+            /**
+             * @brief       Forgets the name of a page that has been removed from the dialog.
+             *
+             * @note        Events that have already been recorded keep the name of the page.
+             *
+             * @param[in]   page the page.
+             */
+            auto removePage(ISettingsPage *page) -> void;
+
+            /**
+             * @brief       Records an event that started at the given time and has just finished.
+             *
+             * @param[in]   name the name of the event.
+             * @param[in]   page the page the event relates to; or nullptr if the event relates to the dialog.
+             * @param[in]   start the timestamp taken when the event started.
+             */
+            auto record(const QString &name, ISettingsPage *page, qint64 start) -> void;
+
+            /**
+             * @brief       Returns the recorded events.
+             *
+             * @returns     the events in the order they finished.
+             */
+            auto events() -> QVector<TraceEvent>;
+
+            /**
+             * @brief       Removes all recorded events.
+             */
+            auto clear() -> void;
+
+            /**
+             * @brief       Returns the recorded events in the Chrome trace event format.
+             *
+             * @note        The result can be loaded into chrome://tracing or Perfetto.
+             *
+             * @returns     the JSON document.
+             */
+            auto toChromeTrace() -> QByteArray;
+
+        private:
+            //! @cond
+
+            QElapsedTimer m_timer;
+            QMutex m_mutex;
+            QVector<TraceEvent> m_events;
+            QHash<ISettingsPage *, QString> m_pageNames;
+
+            //! @endcond
+    };
+}}
+
+#endif // NEDRYSOFT_SETTINGSTRACER_H